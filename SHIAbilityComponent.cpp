@@ -358,45 +358,46 @@ void USHIAbilityComponent::UpdateCooldowns(float DeltaTime)
     }
 }
 
-TArray<FSHIAbilityData> USHIAbilityComponent::GetAbilitiesForWeaponType(const FString& WeaponTypeName) const
+TArray<FSHIAbilityData> USHIAbilityComponent::GetAbilitiesForWeaponType(const USHIItemData* WeaponData) const
 {
-    // This function is now DEPRECATED - we'll use GetAbilitiesFromWeaponData instead
-    // But kept for backward compatibility
-    UE_LOG(LogTemp, Warning, TEXT("Using deprecated GetAbilitiesForWeaponType - should use GetAbilitiesFromWeaponData"));
-    
+    // Fallback for weapons without WeaponAbilities - picks the set from the weapon family trait
     TArray<FSHIAbilityData> WeaponAbilities;
+    if (!WeaponData)
+    {
+        return WeaponAbilities;
+    }
     
-    // Fallback to hard-coded system if needed
-    if (WeaponTypeName.Contains(TEXT("Kılıç")) || WeaponTypeName.Contains(TEXT("Sword")))
+    // Kılıç abilities
+    if (WeaponData->HasTrait(ESHIItemTraits::Kilic))
     {
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::KilicSlash));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::KilicThrust));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::KilicGuard));
     }
     // Balta abilities
-    else if (WeaponTypeName.Contains(TEXT("Balta")) || WeaponTypeName.Contains(TEXT("Axe")))
+    else if (WeaponData->HasTrait(ESHIItemTraits::Balta))
     {
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::BaltaChop));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::BaltaThrow));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::BaltaWhirlwind));
     }
     // Meç abilities
-    else if (WeaponTypeName.Contains(TEXT("Meç")) || WeaponTypeName.Contains(TEXT("Rapier")))
+    else if (WeaponData->HasTrait(ESHIItemTraits::Mec))
     {
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::MecLunge));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::MecParry));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::MecRiposte));
     }
     // Ateş Asası abilities
-    else if (WeaponTypeName.Contains(TEXT("Ateş")) || WeaponTypeName.Contains(TEXT("Fire")) || WeaponTypeName.Contains(TEXT("Asa")))
+    else if (WeaponData->HasTrait(ESHIItemTraits::AtesAsasi))
     {
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::AtesFireball));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::AtesBurn));
         WeaponAbilities.Add(CreateAbilityData(ESHIWeaponAbilityType::AtesIgnite));
     }
     
-    UE_LOG(LogTemp, VeryVerbose, TEXT("Found %d abilities for weapon type: %s"), 
-           WeaponAbilities.Num(), *WeaponTypeName);
+    UE_LOG(LogTemp, VeryVerbose, TEXT("Found %d abilities for weapon: %s"), 
+           WeaponAbilities.Num(), *WeaponData->ItemName.ToString());
     
     return WeaponAbilities;
 }
@@ -418,7 +419,7 @@ TArray<FSHIAbilityData> USHIAbilityComponent::GetAbilitiesFromWeaponData(USHIIte
                *WeaponData->ItemName.ToString());
         
         // Fallback to hard-coded system
-        return GetAbilitiesForWeaponType(WeaponData->ItemName.ToString());
+        return GetAbilitiesForWeaponType(WeaponData);
     }
 
     // Convert FSHIWeaponAbility to FSHIAbilityData
@@ -192,7 +192,7 @@ protected:
     void UpdateCooldowns(float DeltaTime);
 
     // Weapon-specific ability mappings
-    TArray<FSHIAbilityData> GetAbilitiesForWeaponType(const FString& WeaponTypeName) const;
+    TArray<FSHIAbilityData> GetAbilitiesForWeaponType(const USHIItemData* WeaponData) const;
     TArray<FSHIAbilityData> GetAbilitiesFromWeaponData(USHIItemData* WeaponData) const;
     FSHIAbilityData CreateAbilityData(ESHIWeaponAbilityType AbilityType) const;
 
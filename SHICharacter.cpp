@@ -53,6 +53,12 @@ ASHICharacter::ASHICharacter()
     // Create SHI Ability Component
     AbilityComponent = CreateDefaultSubobject<USHIAbilityComponent>(TEXT("AbilityComponent"));
 
+    // Create SHI Item Ownership Component (inventory + equipment + hotbar index)
+    ItemOwnershipComponent = CreateDefaultSubobject<USHIItemOwnershipComponent>(TEXT("ItemOwnershipComponent"));
+
+    // Create SHI Hotbar Component (server owned consumables hotbar)
+    HotbarComponent = CreateDefaultSubobject<USHIHotbarComponent>(TEXT("HotbarComponent"));
+
     // Initialize properties
     CurrentTestItemIndex = 0;
     SpawnItemIndex = 0;
@@ -98,6 +104,7 @@ void ASHICharacter::BeginPlay()
         // Bind equipment events
         EquipmentComponent->OnEquipmentChanged.AddDynamic(this, &ASHICharacter::OnEquipmentChanged);
         EquipmentComponent->OnActiveWeaponChanged.AddDynamic(this, &ASHICharacter::OnActiveWeaponChanged);
+        EquipmentComponent->OnEquipmentSetChanged.AddDynamic(this, &ASHICharacter::OnEquipmentSetChanged);
     }
 
     // Initialize consumables hotbar on client
@@ -112,14 +119,6 @@ void ASHICharacter::BeginPlay()
                 ConsumablesHotbarWidget->AddToViewport();
                 
                 UE_LOG(LogTemp, Log, TEXT("Consumables hotbar initialized"));
-                
-                // Add some test consumables for testing
-                if (TestPotionItem)
-                {
-                    ConsumablesHotbarWidget->SetSlotItem(3, TestPotionItem, 5);
-                    ConsumablesHotbarWidget->SetSlotItem(4, TestPotionItem, 3);
-                    UE_LOG(LogTemp, Log, TEXT("Test consumables added to hotbar"));
-                }
             }
         }
     }
@@ -491,42 +490,8 @@ void ASHICharacter::TestEquipItem()
 // ⬅️ NEW: File sonuna TestPopulateHotbar implementation ekle
 void ASHICharacter::TestPopulateHotbar()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Populating hotbar with test consumables"));
-
-    // Test consumable items (hardcoded for now)
-    TArray<FString> TestConsumableNames = {
-        TEXT("Health Potion"),
-        TEXT("Mana Potion"), 
-        TEXT("Stamina Potion"),
-        TEXT("Speed Potion")
-    };
-
-    // Create test consumable items and add to hotbar
-    for (int32 i = 0; i < 4; i++)
-    {
-        int32 SlotIndex = i + 3; // Slots 3,4,5,6
-        
-        // Create a temporary test consumable item
-        USHIItemData* TestConsumable = NewObject<USHIItemData>();
-        if (TestConsumable)
-        {
-            TestConsumable->ItemName = FText::FromString(TestConsumableNames[i]);
-            TestConsumable->ItemType = ESHIItemType::Tuketim;
-            TestConsumable->ItemDescription = FText::FromString(FString::Printf(TEXT("Test %s for hotbar slot %d"), *TestConsumableNames[i], SlotIndex));
-            TestConsumable->MaxStackSize = 10;
-            
-            // Add to hotbar with quantity 5
-            SetHotbarSlot(SlotIndex, TestConsumable, 5);
-            
-            UE_LOG(LogTemp, Log, TEXT("Added %s to hotbar slot %d"), *TestConsumableNames[i], SlotIndex);
-        }
-    }
-
-    // Visual feedback
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Magenta, TEXT("Hotbar Populated with Test Items!"));
-    }
+    // Client-side call, forward to server
+    Server_TestPopulateHotbar();
 
     // Also show usage instructions
     if (GEngine)
@@ -569,7 +534,15 @@ void ASHICharacter::OnEquipmentChanged(ESHIEquipmentSlot SlotType, USHIItemData*
         UE_LOG(LogTemp, Log, TEXT("Equipment removed from slot %d"), (int32)SlotType);
     }
 
-    // Recalculate stats when equipment changes
+    // Recalculate stats when equipment changes - batched changes recalculate once in OnEquipmentSetChanged
+    if (!EquipmentComponent->IsBroadcastingEquipmentSet())
+    {
+        RecalculateStatsFromEquipment();
+    }
+}
+
+void ASHICharacter::OnEquipmentSetChanged()
+{
     RecalculateStatsFromEquipment();
 }
 
@@ -606,20 +579,12 @@ void ASHICharacter::RecalculateStatsFromEquipment()
         return;
     }
 
-    // Get all equipment stat bonuses
-    TArray<FSHIStatModifier> EquipmentBonuses = EquipmentComponent->GetAllEquipmentStatBonuses();
-    
-    UE_LOG(LogTemp, Log, TEXT("Recalculating stats from equipment: %d bonuses found"), EquipmentBonuses.Num());
+    // The equipment component keeps the bonus total up to date on every equip/unequip
+    const FSHIStatVector& EquipmentBonuses = EquipmentComponent->GetEquipmentStatTotal();
     
-    // FIX: ACTUALLY APPLY THE BONUSES TO STATS COMPONENT
-    StatsComponent->ApplyEquipmentBonuses(EquipmentBonuses);
+    UE_LOG(LogTemp, Log, TEXT("Recalculating stats from equipment: %d items equipped"), EquipmentComponent->GetEquippedItemCount());
     
-    // Log the results for debugging
-    for (const FSHIStatModifier& Bonus : EquipmentBonuses)
-    {
-        UE_LOG(LogTemp, VeryVerbose, TEXT("Applied equipment bonus: %s +%f"), 
-            *Bonus.StatName.ToString(), Bonus.BonusAmount);
-    }
+    StatsComponent->SetEquipmentBonuses(EquipmentBonuses);
     
     // Show updated stats on screen for testing
     if (GEngine)
@@ -725,12 +690,16 @@ void ASHICharacter::UseConsumableSlot(int32 SlotIndex)
 
 void ASHICharacter::SetHotbarSlot(int32 SlotIndex, USHIItemData* Item, int32 Quantity)
 {
-    if (ConsumablesHotbarWidget)
+    if (!HasAuthority())
     {
-        ConsumablesHotbarWidget->SetSlotItem(SlotIndex, Item, Quantity);
-        
-        UE_LOG(LogTemp, Log, TEXT("Hotbar slot %d set to: %s x%d"), 
-               SlotIndex, Item ? *Item->ItemName.ToString() : TEXT("Empty"), Quantity);
+        UE_LOG(LogTemp, Warning, TEXT("SetHotbarSlot: hotbar can only be changed on the server"));
+        return;
+    }
+
+    if (HotbarComponent)
+    {
+        // Widgets refresh from the replicated hotbar
+        HotbarComponent->SetSlotItem(SlotIndex, Item, Quantity);
     }
 }
 
@@ -761,8 +730,70 @@ void ASHICharacter::Server_TestStatIncrease_Implementation()
     }
 }
 
+void ASHICharacter::Server_TestPopulateHotbar_Implementation()
+{
+#if !UE_BUILD_SHIPPING
+    // Fills the hotbar straight from asset references, bypassing the inventory
+    if (!CanRunTestCommands())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Test hotbar fill rejected - cheats are not enabled for this player"));
+        return;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("Populating hotbar with test consumables"));
+
+    if (!HotbarComponent)
+    {
+        return;
+    }
+
+    // Test consumables configured in Blueprint, the test potion otherwise
+    TArray<USHIItemData*> HotbarTestItems;
+    for (USHIItemData* Item : TestConsumableItems)
+    {
+        if (Item && Item->ItemType == ESHIItemType::Tuketim)
+        {
+            HotbarTestItems.Add(Item);
+        }
+    }
+    if (HotbarTestItems.Num() == 0 && TestPotionItem)
+    {
+        HotbarTestItems.Add(TestPotionItem);
+    }
+
+    if (HotbarTestItems.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No test consumables configured"));
+        return;
+    }
+
+    for (int32 i = 0; i < USHIHotbarComponent::NumSlots; i++)
+    {
+        int32 SlotIndex = i + USHIHotbarComponent::FirstSlotKey; // Slots 3,4,5,6
+
+        // Add to hotbar with quantity 5
+        USHIItemData* TestConsumable = HotbarTestItems[i % HotbarTestItems.Num()];
+        HotbarComponent->SetSlotItem(SlotIndex, TestConsumable, 5);
+    }
+
+    // Visual feedback
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Magenta, TEXT("Hotbar Populated with Test Items!"));
+    }
+#endif
+}
+
 void ASHICharacter::Server_TestAddItem_Implementation()
 {
+#if !UE_BUILD_SHIPPING
+    // Grants items straight from asset references
+    if (!CanRunTestCommands())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Test add item rejected - cheats are not enabled for this player"));
+        return;
+    }
+
     if (InventoryComponent)
     {
         // Test items array
@@ -785,18 +816,18 @@ void ASHICharacter::Server_TestAddItem_Implementation()
                     AddQuantity = 10; // Add 10 materials
                 }
 
-                // Check if we can add the item
-                if (InventoryComponent->CanAddItem(CurrentItem, AddQuantity))
+                // Add as much as fits (single pass, partial adds allowed)
+                const int32 AddedQuantity = InventoryComponent->TryAddItem(CurrentItem, AddQuantity);
+                if (AddedQuantity > 0)
                 {
-                    InventoryComponent->Server_AddItem(CurrentItem, AddQuantity);
                     UE_LOG(LogTemp, Warning, TEXT("Added %d of %s to inventory"),
-                           AddQuantity, *CurrentItem->ItemName.ToString());
+                           AddedQuantity, *CurrentItem->ItemName.ToString());
 
                     // Screen feedback
                     if (GEngine)
                     {
                         FString ItemText = FString::Printf(TEXT("Eklendi: %s x%d"),
-                                                         *CurrentItem->ItemName.ToString(), AddQuantity);
+                                                         *CurrentItem->ItemName.ToString(), AddedQuantity);
                         GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, ItemText);
                     }
 
@@ -829,16 +860,9 @@ void ASHICharacter::Server_TestAddItem_Implementation()
         // Show inventory status
         int32 EmptySlot = InventoryComponent->FindFirstEmptySlot();
         int32 TotalSlots = InventoryComponent->InventorySize;
-        int32 UsedSlots = 0;
 
-        // Count used slots
-        for (int32 i = 0; i < TotalSlots; i++)
-        {
-            if (!InventoryComponent->GetSlot(i).IsEmpty())
-            {
-                UsedSlots++;
-            }
-        }
+        // Count used slots - from the replicated used count, which also covers unviewed pages
+        int32 UsedSlots = InventoryComponent->GetUsedSlotCount();
 
         if (GEngine)
         {
@@ -866,6 +890,7 @@ void ASHICharacter::Server_TestAddItem_Implementation()
     {
         UE_LOG(LogTemp, Error, TEXT("Inventory component not found!"));
     }
+#endif
 }
 
 void ASHICharacter::Server_InteractWithItem_Implementation()
@@ -920,6 +945,14 @@ void ASHICharacter::Server_InteractWithItem_Implementation()
 
 void ASHICharacter::Server_TestSpawnItem_Implementation()
 {
+#if !UE_BUILD_SHIPPING
+    // Spawns pickups straight from asset references
+    if (!CanRunTestCommands())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Test spawn rejected - cheats are not enabled for this player"));
+        return;
+    }
+
     // Test items array
     TArray<USHIItemData*> TestItems = {TestSwordItem, TestPotionItem, TestMaterialItem};
 
@@ -977,10 +1010,30 @@ void ASHICharacter::Server_TestSpawnItem_Implementation()
     {
         UE_LOG(LogTemp, Warning, TEXT("No test items configured for spawning"));
     }
+#endif
+}
+
+bool ASHICharacter::CanRunTestCommands() const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    // The cheat manager only exists where the game mode allows cheats (standalone, PIE)
+    const APlayerController* PC = Cast<APlayerController>(GetController());
+    return HasAuthority() && PC && PC->CheatManager;
+#endif
 }
 
 void ASHICharacter::Server_TestEquipItem_Implementation()
 {
+#if !UE_BUILD_SHIPPING
+    // Equips test items straight from asset references, bypassing the inventory
+    if (!CanRunTestCommands())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Test equip rejected - cheats are not enabled for this player"));
+        return;
+    }
+
     if (!EquipmentComponent)
     {
         UE_LOG(LogTemp, Error, TEXT("Equipment component not found!"));
@@ -1055,8 +1108,8 @@ void ASHICharacter::Server_TestEquipItem_Implementation()
         }
     }
 
-    // Equip the item (ORIGINAL LOGIC)
-    EquipmentComponent->Server_EquipItem(TargetSlot, ItemToEquip, 1);
+    // Equip the item - test items are not in the inventory, so bypass it
+    EquipmentComponent->ForceEquipItem(TargetSlot, ItemToEquip, 1);
 
     // Update cycle index (ORIGINAL LOGIC)
     CurrentTestEquipIndex = (CurrentTestEquipIndex + 1) % TestItems.Num();
@@ -1078,19 +1131,27 @@ void ASHICharacter::Server_TestEquipItem_Implementation()
     {
         EquipmentComponent->DebugPrintEquipment();
     }
+#endif
 }
 
 void ASHICharacter::Server_UseConsumableSlot_Implementation(int32 SlotNumber)
 {
-    // Server-side validation and sync
-    UE_LOG(LogTemp, Log, TEXT("Server: Consumable slot %d used"), SlotNumber);
-    
-    // Here you would:
-    // 1. Validate the consumable usage
-    // 2. Apply server-side effects
-    // 3. Update client states
-    
-    // For now, just log
+    // Server-side validation - the hotbar removes one consumable and replicates the new count
+    USHIItemData* UsedItem = HotbarComponent ? HotbarComponent->ConsumeSlot(SlotNumber) : nullptr;
+    if (!UsedItem)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Server: Consumable slot %d could not be used"), SlotNumber);
+        return;
+    }
+
+    // Effect is applied here, in the same step that removed the consumable
+    if (StatsComponent)
+    {
+        StatsComponent->ApplyConsumable(UsedItem);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Server: Consumable slot %d used (%s)"), SlotNumber, *UsedItem->ItemName.ToString());
+
     if (GEngine)
     {
         FString ServerText = FString::Printf(TEXT("Server: Slot %d validated"), SlotNumber);
@@ -1215,16 +1276,8 @@ void ASHICharacter::DebugPrintAllSystems() const
     // Inventory debug
     if (InventoryComponent)
     {
-        int32 UsedSlots = 0;
-        for (int32 i = 0; i < InventoryComponent->InventorySize; i++)
-        {
-            FSHIInventorySlot Slot = InventoryComponent->GetSlot(i);
-            if (Slot.ItemData != nullptr)
-            {
-                UsedSlots++;
-            }
-        }
-        UE_LOG(LogTemp, Log, TEXT("Inventory: %d/%d slots used"), UsedSlots, InventoryComponent->InventorySize);
+        UE_LOG(LogTemp, Log, TEXT("Inventory: %d/%d slots used"),
+               InventoryComponent->GetUsedSlotCount(), InventoryComponent->InventorySize);
     }
 
     UE_LOG(LogTemp, Log, TEXT("=== END SYSTEM DEBUG ==="));
@@ -1248,7 +1301,7 @@ void ASHICharacter::TestEquipShieldDirect()
     }
 
     // Direct shield equip attempt
-    EquipmentComponent->Server_EquipItem(ESHIEquipmentSlot::Kalkan, TestShieldItem, 1);
+    EquipmentComponent->Server_EquipItem(ESHIEquipmentSlot::Kalkan, TestShieldItem);
     
     if (GEngine)
     {
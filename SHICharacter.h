@@ -6,6 +6,8 @@
 #include "Components/SHIInventoryComponent.h"
 #include "Components/SHIEquipmentComponent.h"
 #include "Components/SHIAbilityComponent.h"
+#include "Components/SHIItemOwnershipComponent.h"
+#include "Components/SHIHotbarComponent.h"
 #include "Data/SHIItemData.h"
 #include "Systems/SHIWorldItem.h"
 #include "UI/SHIEquipmentPanelWidget.h"
@@ -124,6 +126,12 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SHI Components")
     USHIAbilityComponent* AbilityComponent;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SHI Components")
+    USHIItemOwnershipComponent* ItemOwnershipComponent;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SHI Components")
+    USHIHotbarComponent* HotbarComponent;
+
     // UI Components
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
     TSubclassOf<USHICharacterStatsWidget> StatsWidgetClass;
@@ -212,11 +220,18 @@ public:
     UFUNCTION(BlueprintPure, Category = "SHI Abilities")
     USHIAbilityComponent* GetAbilityComponent() const { return AbilityComponent; }
 
+    UFUNCTION(BlueprintPure, Category = "SHI Inventory")
+    USHIItemOwnershipComponent* GetItemOwnershipComponent() const { return ItemOwnershipComponent; }
+
+    UFUNCTION(BlueprintPure, Category = "SHI Consumables")
+    USHIHotbarComponent* GetHotbarComponent() const { return HotbarComponent; }
+
     // Consumables hotbar functions
     UFUNCTION(BlueprintCallable, Category = "SHI Consumables")
     void UseConsumableSlot(int32 SlotIndex);
 
-    UFUNCTION(BlueprintCallable, Category = "SHI Consumables") 
+    // Server only - the hotbar is owned by the server and replicated to this player
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "SHI Consumables") 
     void SetHotbarSlot(int32 SlotIndex, USHIItemData* Item, int32 Quantity);
 
 protected:
@@ -299,6 +314,9 @@ protected:
     UFUNCTION(Server, Reliable, BlueprintCallable, Category = "SHI Network")
     void Server_TestAddItem();
 
+    UFUNCTION(Server, Reliable, BlueprintCallable, Category = "SHI Network")
+    void Server_TestPopulateHotbar();
+
     UFUNCTION(Server, Reliable, BlueprintCallable, Category = "SHI Network")
     void Server_InteractWithItem();
 
@@ -327,9 +345,15 @@ protected:
     UFUNCTION()
     void OnActiveWeaponChanged(ESHIEquipmentSlot NewActiveWeapon);
 
+    UFUNCTION()
+    void OnEquipmentSetChanged();
+
     // Stats recalculation
     void RecalculateStatsFromEquipment();
 
+    // Server side gate for the test RPCs - never in shipping, otherwise only for players allowed to cheat
+    bool CanRunTestCommands() const;
+
     // Debug function
     UFUNCTION(BlueprintCallable, Category = "SHI Debug")
     void DebugPrintAllSystems() const;
@@ -1,6 +1,5 @@
 ﻿#include "SHIConsumablesHotbarWidget.h"
 #include "Player/SHICharacter.h"
-#include "Components/SHIStatsComponent.h"
 #include "Components/SHIInventoryComponent.h"
 #include "SHIConsumableSlotWidget.h"
 #include "Engine/Engine.h"
@@ -9,12 +8,7 @@ USHIConsumablesHotbarWidget::USHIConsumablesHotbarWidget(const FObjectInitialize
     : Super(ObjectInitializer)
 {
     OwnerCharacter = nullptr;
-    // Initialize 4 hotbar slots (for keys 3,4,5,6)
-    HotbarSlots.SetNum(4);
-    for (int32 i = 0; i < 4; i++)
-    {
-        HotbarSlots[i] = FConsumableSlotData();
-    }
+    HotbarComponent = nullptr;
 }
 
 void USHIConsumablesHotbarWidget::NativeConstruct()
@@ -33,6 +27,17 @@ void USHIConsumablesHotbarWidget::SetOwnerCharacter(ASHICharacter* Character)
 
     OwnerCharacter = Character;
 
+    // Follow the replicated hotbar instead of keeping a local copy
+    if (HotbarComponent)
+    {
+        HotbarComponent->OnHotbarSlotChanged.RemoveDynamic(this, &USHIConsumablesHotbarWidget::HandleHotbarSlotChanged);
+    }
+    HotbarComponent = OwnerCharacter->GetHotbarComponent();
+    if (HotbarComponent)
+    {
+        HotbarComponent->OnHotbarSlotChanged.AddDynamic(this, &USHIConsumablesHotbarWidget::HandleHotbarSlotChanged);
+    }
+
     // Initialize slot widgets
     TArray<USHIConsumableSlotWidget*> SlotWidgets = {Slot3Widget, Slot4Widget, Slot5Widget, Slot6Widget};
     for (int32 i = 0; i < SlotWidgets.Num(); i++)
@@ -46,44 +51,20 @@ void USHIConsumablesHotbarWidget::SetOwnerCharacter(ASHICharacter* Character)
 
     // Initial display refresh
     RefreshAllSlots();
+
     UE_LOG(LogTemp, Log, TEXT("Consumables hotbar initialized for character"));
 }
 
-void USHIConsumablesHotbarWidget::SetSlotItem(int32 SlotIndex, USHIItemData* Item, int32 Quantity)
+void USHIConsumablesHotbarWidget::HandleHotbarSlotChanged(int32 SlotIndex, const FConsumableSlotData& SlotData)
 {
-    UE_LOG(LogTemp, Log, TEXT("=== SetSlotItem Called: Slot %d ==="), SlotIndex);
-
-    int32 ArrayIndex = SlotIndex - 3; // Convert key number to array index
-
-    if (!IsValidSlotIndex(SlotIndex))
-    {
-        UE_LOG(LogTemp, Warning, TEXT("SetSlotItem: Invalid hotbar slot index: %d"), SlotIndex);
-        return;
-    }
-
-    if (ArrayIndex < 0 || ArrayIndex >= HotbarSlots.Num())
-    {
-        UE_LOG(LogTemp, Error, TEXT("SetSlotItem: ArrayIndex out of bounds: %d (max: %d)"), ArrayIndex, HotbarSlots.Num());
-        return;
-    }
-
-    // Update hotbar data
-    HotbarSlots[ArrayIndex].ItemData = Item;
-    HotbarSlots[ArrayIndex].Quantity = FMath::Max(0, Quantity);
-
-    // Update visual display
     RefreshSlotDisplay(SlotIndex);
-
-    UE_LOG(LogTemp, Log, TEXT("Hotbar slot %d set to: %s x%d"),
-        SlotIndex, Item ? *Item->ItemName.ToString() : TEXT("Empty"), Quantity);
 }
 
 void USHIConsumablesHotbarWidget::UseSlot(int32 SlotIndex)
 {
     UE_LOG(LogTemp, Warning, TEXT("=== Hotbar UseSlot Called: %d ==="), SlotIndex);
 
-    int32 ArrayIndex = SlotIndex - 3;
-    
+
     if (!IsValidSlotIndex(SlotIndex))
     {
         UE_LOG(LogTemp, Error, TEXT("Invalid slot index: %d"), SlotIndex);
@@ -102,13 +83,14 @@ void USHIConsumablesHotbarWidget::UseSlot(int32 SlotIndex)
         return;
     }
 
-    if (ArrayIndex < 0 || ArrayIndex >= HotbarSlots.Num())
+    if (!HotbarComponent)
     {
-        UE_LOG(LogTemp, Error, TEXT("ArrayIndex out of bounds: %d (max: %d)"), ArrayIndex, HotbarSlots.Num());
+        UE_LOG(LogTemp, Error, TEXT("HotbarComponent is NULL"));
         return;
     }
 
-    FConsumableSlotData& SlotData = HotbarSlots[ArrayIndex];
+    // Replicated copy - the server removes the consumable, this only checks it and shows feedback
+    const FConsumableSlotData SlotData = HotbarComponent->GetSlot(SlotIndex);
     
     if (SlotData.IsEmpty())
     {
@@ -145,21 +127,9 @@ void USHIConsumablesHotbarWidget::UseSlot(int32 SlotIndex)
     // Store item name for feedback before it might be cleared
     FString ItemName = SlotData.ItemData->ItemName.ToString();
 
-    // Apply consumable effect with safety
+    // Show the consumable effect (applied on the server)
     ApplyConsumableEffect(SlotData.ItemData);
 
-    // Decrease quantity
-    SlotData.Quantity--;
-    
-    if (SlotData.Quantity <= 0)
-    {
-        SlotData.ItemData = nullptr;
-        SlotData.Quantity = 0;
-    }
-
-    // Update display
-    RefreshSlotDisplay(SlotIndex);
-
     // Show feedback with stored item name
     if (GEngine)
     {
@@ -198,23 +168,15 @@ void USHIConsumablesHotbarWidget::ApplyConsumableEffect(USHIItemData* Item)
         return;
     }
 
-    USHIStatsComponent* StatsComp = OwnerCharacter->GetStatsComponent();
-    if (!StatsComp) 
-    {
-        UE_LOG(LogTemp, Warning, TEXT("ApplyConsumableEffect: No StatsComponent found"));
-        // Don't return here - we can still show effects without stats
-    }
-
-    // Apply effects based on item name (simplified system)
-    FString ItemName = Item->ItemName.ToString().ToLower();
-    UE_LOG(LogTemp, Log, TEXT("Applying effect for item: %s"), *ItemName);
+    // The server applies the effect when it removes the consumable - this only shows feedback
+    UE_LOG(LogTemp, Log, TEXT("Showing effect for item: %s"), *Item->ItemName.ToString());
 
-    if (ItemName.Contains("potion") || ItemName.Contains("iksir") || ItemName.Contains("health"))
+    if (Item->HasTrait(ESHIItemTraits::SaglikIksiri))
     {
         // Health potion effect
-        float HealAmount = 50.0f; // Base heal amount
+        float HealAmount = Item->GetRestoreAmount();
         
-        UE_LOG(LogTemp, Warning, TEXT("Applied health potion: +%.0f health"), HealAmount);
+        UE_LOG(LogTemp, Warning, TEXT("Used health potion: +%.0f health"), HealAmount);
         
         if (GEngine)
         {
@@ -222,12 +184,12 @@ void USHIConsumablesHotbarWidget::ApplyConsumableEffect(USHIItemData* Item)
             GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, HealText);
         }
     }
-    else if (ItemName.Contains("mana"))
+    else if (Item->HasTrait(ESHIItemTraits::EnerjiIksiri))
     {
         // Mana potion effect
-        float ManaAmount = 30.0f;
+        float ManaAmount = Item->GetRestoreAmount();
         
-        UE_LOG(LogTemp, Warning, TEXT("Applied mana potion: +%.0f mana"), ManaAmount);
+        UE_LOG(LogTemp, Warning, TEXT("Used mana potion: +%.0f mana"), ManaAmount);
         
         if (GEngine)
         {
@@ -267,14 +229,13 @@ void USHIConsumablesHotbarWidget::RefreshSlotDisplay(int32 SlotIndex)
         return;
     }
 
-    int32 ArrayIndex = SlotIndex - 3;
-    if (ArrayIndex < 0 || ArrayIndex >= HotbarSlots.Num())
+    if (!HotbarComponent)
     {
-        UE_LOG(LogTemp, Error, TEXT("RefreshSlotDisplay: ArrayIndex out of bounds: %d"), ArrayIndex);
+        UE_LOG(LogTemp, Warning, TEXT("RefreshSlotDisplay: No hotbar component for slot %d"), SlotIndex);
         return;
     }
 
-    const FConsumableSlotData& SlotData = HotbarSlots[ArrayIndex];
+    const FConsumableSlotData SlotData = HotbarComponent->GetSlot(SlotIndex);
 
     SlotWidget->SetItem(SlotData.ItemData, SlotData.Quantity);
     UE_LOG(LogTemp, VeryVerbose, TEXT("RefreshSlotDisplay completed for slot %d"), SlotIndex);
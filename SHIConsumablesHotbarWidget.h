@@ -3,32 +3,13 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Data/SHIItemData.h"
+#include "Components/SHIHotbarComponent.h"
 #include "SHIConsumablesHotbarWidget.generated.h"
 
 class ASHICharacter;
 class USHIConsumableSlotWidget;
 class UHorizontalBox;
 
-USTRUCT(BlueprintType)
-struct FConsumableSlotData
-{
-    GENERATED_BODY()
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    USHIItemData* ItemData;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    int32 Quantity;
-
-    FConsumableSlotData()
-    {
-        ItemData = nullptr;
-        Quantity = 0;
-    }
-
-    bool IsEmpty() const { return ItemData == nullptr || Quantity <= 0; }
-};
-
 UCLASS()
 class STILLHEREISTANBUL_API USHIConsumablesHotbarWidget : public UUserWidget
 {
@@ -57,18 +38,18 @@ protected:
     UPROPERTY()
     ASHICharacter* OwnerCharacter;
 
-    // Hotbar data (slots 3,4,5,6)
+    // Hotbar data lives on the character's server owned hotbar component
     UPROPERTY()
-    TArray<FConsumableSlotData> HotbarSlots;
+    USHIHotbarComponent* HotbarComponent;
+
+    UFUNCTION()
+    void HandleHotbarSlotChanged(int32 SlotIndex, const FConsumableSlotData& SlotData);
 
 public:
     // Setup functions
     UFUNCTION(BlueprintCallable, Category = "SHI Consumables")
     void SetOwnerCharacter(ASHICharacter* Character);
 
-    UFUNCTION(BlueprintCallable, Category = "SHI Consumables")
-    void SetSlotItem(int32 SlotIndex, USHIItemData* Item, int32 Quantity);
-
     UFUNCTION(BlueprintCallable, Category = "SHI Consumables")
     void UseSlot(int32 SlotIndex);
 
@@ -78,7 +59,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SHI Consumables")
     void RefreshAllSlots();
 
-    // Consumable effect application
+    // Consumable effect feedback (the server applies the effect)
     void ApplyConsumableEffect(USHIItemData* Item);
 
 private:
@@ -4,6 +4,112 @@
 #include "Components/SHIInventoryComponent.h"
 #include "Player/SHICharacter.h"
 
+namespace
+{
+    // Slot contents as last sent to one connection
+    class FSHIEquipmentDeltaState : public INetDeltaBaseState
+    {
+    public:
+        const USHIItemData* Items[FSHIEquipmentState::NumSlots] = {};
+        int32 Quantities[FSHIEquipmentState::NumSlots] = {};
+        ESHIEquipmentSlot ActiveWeaponSlot = ESHIEquipmentSlot::None;
+
+        virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+        {
+            const FSHIEquipmentDeltaState* Other = static_cast<const FSHIEquipmentDeltaState*>(OtherState);
+            return FMemory::Memcmp(Items, Other->Items, sizeof(Items)) == 0 &&
+                   FMemory::Memcmp(Quantities, Other->Quantities, sizeof(Quantities)) == 0 &&
+                   ActiveWeaponSlot == Other->ActiveWeaponSlot;
+        }
+    };
+}
+
+bool FSHIEquipmentState::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+    if (DeltaParms.Writer)
+    {
+        const FSHIEquipmentDeltaState* OldState = static_cast<const FSHIEquipmentDeltaState*>(DeltaParms.OldState);
+        TSharedPtr<FSHIEquipmentDeltaState> NewState = MakeShared<FSHIEquipmentDeltaState>();
+
+        // No base yet = everything changed
+        uint16 ChangedMask = 0;
+        for (int32 i = 1; i < NumSlots; i++)
+        {
+            NewState->Items[i] = Slots[i].IsEmpty() ? nullptr : Slots[i].ItemData;
+            NewState->Quantities[i] = NewState->Items[i] ? Slots[i].Quantity : 0;
+            if (!OldState || OldState->Items[i] != NewState->Items[i] || OldState->Quantities[i] != NewState->Quantities[i])
+            {
+                ChangedMask |= 1 << i;
+            }
+        }
+
+        NewState->ActiveWeaponSlot = ActiveWeaponSlot;
+        if (!OldState || OldState->ActiveWeaponSlot != ActiveWeaponSlot)
+        {
+            ChangedMask |= ActiveWeaponBit;
+        }
+
+        if (ChangedMask == 0)
+        {
+            return false;
+        }
+
+        FBitWriter& Writer = *DeltaParms.Writer;
+        bool bSlotSuccess = true;
+        Writer.SerializeBits(&ChangedMask, NumSlots + 1);
+        for (int32 i = 1; i < NumSlots; i++)
+        {
+            if (ChangedMask & (1 << i))
+            {
+                FSHIEquipmentSlot Sent;
+                Sent.ItemData = const_cast<USHIItemData*>(NewState->Items[i]);
+                Sent.Quantity = NewState->Quantities[i];
+                Sent.NetSerialize(Writer, DeltaParms.Map, bSlotSuccess);
+            }
+        }
+        if (ChangedMask & ActiveWeaponBit)
+        {
+            uint8 ActiveSlot = (uint8)ActiveWeaponSlot;
+            Writer.SerializeBits(&ActiveSlot, 4);
+        }
+
+        *DeltaParms.NewState = NewState;
+        return true;
+    }
+
+    if (DeltaParms.Reader)
+    {
+        FBitReader& Reader = *DeltaParms.Reader;
+        bool bSlotSuccess = true;
+
+        uint16 ChangedMask = 0;
+        Reader.SerializeBits(&ChangedMask, NumSlots + 1);
+        for (int32 i = 1; i < NumSlots; i++)
+        {
+            if (ChangedMask & (1 << i))
+            {
+                Slots[i].NetSerialize(Reader, DeltaParms.Map, bSlotSuccess);
+            }
+        }
+        if (ChangedMask & ActiveWeaponBit)
+        {
+            uint8 ActiveSlot = 0;
+            Reader.SerializeBits(&ActiveSlot, 4);
+            if (IsValidSlot(static_cast<ESHIEquipmentSlot>(ActiveSlot)))
+            {
+                ActiveWeaponSlot = static_cast<ESHIEquipmentSlot>(ActiveSlot);
+            }
+        }
+
+        // Several deltas can land before one OnRep
+        ReceivedChangeMask |= ChangedMask;
+        return !Reader.IsError();
+    }
+
+    // Object references go through the item registry
+    return false;
+}
+
 USHIEquipmentComponent::USHIEquipmentComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
@@ -11,6 +117,10 @@ USHIEquipmentComponent::USHIEquipmentComponent()
 
     // Initialize equipment state
     EquipmentState = FSHIEquipmentState();
+    for (USHIItemData*& Item : LastReplicatedItems)
+    {
+        Item = nullptr;
+    }
 }
 
 void USHIEquipmentComponent::BeginPlay()
@@ -18,16 +128,17 @@ void USHIEquipmentComponent::BeginPlay()
     Super::BeginPlay();
     
     UE_LOG(LogTemp, Warning, TEXT("SHI Equipment Component initialized"));
-    UE_LOG(LogTemp, Log, TEXT("Equipment slots initialized: 8 slots ready"));
+    UE_LOG(LogTemp, Log, TEXT("Equipment slots initialized: %d slots ready"), FSHIEquipmentState::NumSlots - 1);
 }
 
 void USHIEquipmentComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     DOREPLIFETIME(USHIEquipmentComponent, EquipmentState);
+    DOREPLIFETIME_CONDITION(USHIEquipmentComponent, Loadouts, COND_OwnerOnly);
 }
 
-void USHIEquipmentComponent::Server_EquipItem_Implementation(ESHIEquipmentSlot SlotType, USHIItemData* ItemData, int32 Quantity)
+void USHIEquipmentComponent::Server_EquipItem_Implementation(ESHIEquipmentSlot SlotType, USHIItemData* ItemData)
 {
     if (!ItemData || SlotType == ESHIEquipmentSlot::None)
     {
@@ -35,35 +146,153 @@ void USHIEquipmentComponent::Server_EquipItem_Implementation(ESHIEquipmentSlot S
         return;
     }
 
-    // Get slot reference
-    FSHIEquipmentSlot* TargetSlot = EquipmentState.GetSlotByType(SlotType);
-    if (!TargetSlot)
+    // The client only names the item - it has to come out of the owner's inventory
+    USHIInventoryComponent* Inventory = GetOwnerInventory();
+    const int32 InventorySlot = Inventory ? Inventory->FindItemSlot(ItemData) : INDEX_NONE;
+    if (InventorySlot == INDEX_NONE)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Invalid equipment slot type: %d"), (int32)SlotType);
+        UE_LOG(LogTemp, Warning, TEXT("Cannot equip %s - not in the inventory"), *ItemData->ItemName.ToString());
         return;
     }
 
+    EquipFromInventory(InventorySlot, SlotType);
+}
+
+void USHIEquipmentComponent::Server_EquipFromInventory_Implementation(int32 InventorySlot, ESHIEquipmentSlot SlotType)
+{
+    EquipFromInventory(InventorySlot, SlotType);
+}
+
+bool USHIEquipmentComponent::EquipFromInventory(int32 InventorySlot, ESHIEquipmentSlot SlotType)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return false;
+    }
+
+    USHIInventoryComponent* Inventory = GetOwnerInventory();
+    const FSHIEquipmentSlot* TargetSlot = EquipmentState.GetSlotByType(SlotType);
+    if (!Inventory || !TargetSlot)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid equipment slot type: %d"), (int32)SlotType);
+        return false;
+    }
+
+    const FSHIInventorySlot SourceSlot = Inventory->GetSlot(InventorySlot);
+    USHIItemData* ItemData = SourceSlot.ItemData;
+    if (SourceSlot.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot equip from empty inventory slot %d"), InventorySlot);
+        return false;
+    }
+
+    if (!CanEquipIntoSlot(SlotType, ItemData))
+    {
+        return false;
+    }
+
+    // One inventory transaction: take the item, put back whatever the slot held (into the freed slot when possible)
+    TArray<FSHIInventoryOp> Operations;
+    FSHIInventoryOp& Take = Operations.AddDefaulted_GetRef();
+    Take.OpType = ESHIInventoryOpType::Remove;
+    Take.ItemData = ItemData;
+    Take.Quantity = 1;
+    Take.SlotIndex = InventorySlot;
+
+    if (!TargetSlot->IsEmpty())
+    {
+        FSHIInventoryOp& GiveBack = Operations.AddDefaulted_GetRef();
+        GiveBack.OpType = ESHIInventoryOpType::Add;
+        GiveBack.ItemData = TargetSlot->ItemData;
+        GiveBack.Quantity = TargetSlot->Quantity;
+        GiveBack.SlotIndex = SourceSlot.Quantity == 1 ? InventorySlot : INDEX_NONE;
+    }
+
+    // Replacing the sword takes the shield off in the same transaction
+    const bool bReturnShield = AddShieldReturnIfNeeded(SlotType, ItemData, Operations);
+
+    if (!Inventory->ApplyBatch(Operations))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Equip of %s rolled back - no room for the replaced item"), *ItemData->ItemName.ToString());
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("Envanter dolu - eşya değiştirilemedi"));
+        }
+        return false;
+    }
+
+    SetSlotItem(SlotType, ItemData, 1);
+    if (bReturnShield)
+    {
+        ClearShieldWithoutSword();
+    }
+    return true;
+}
+
+bool USHIEquipmentComponent::ForceEquipItem(ESHIEquipmentSlot SlotType, USHIItemData* ItemData, int32 Quantity)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority() || !ItemData || !CanEquipIntoSlot(SlotType, ItemData))
+    {
+        return false;
+    }
+
+    // Test path - the item does not come from the inventory and a replaced item is discarded
+    SetSlotItem(SlotType, ItemData, FMath::Max(Quantity, 1));
+
+    // So is a shield left without a sword
+    const FSHIEquipmentSlot* ShieldSlot = EquipmentState.GetSlotByType(ESHIEquipmentSlot::Kalkan);
+    if (IsWeaponSlot(SlotType) && ShieldSlot && !ShieldSlot->IsEmpty() && !HasValidSwordEquipped())
+    {
+        ClearShieldWithoutSword();
+    }
+    return true;
+}
+
+bool USHIEquipmentComponent::CanEquipIntoSlot(ESHIEquipmentSlot SlotType, USHIItemData* ItemData) const
+{
+    if (!FSHIEquipmentState::IsValidSlot(SlotType))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid equipment slot type: %d"), (int32)SlotType);
+        return false;
+    }
+
     // Validate item can be equipped in this slot
     if (!IsValidEquipmentSlot(SlotType, ItemData))
     {
         UE_LOG(LogTemp, Warning, TEXT("Item %s cannot be equipped in slot %d"), 
                *ItemData->ItemName.ToString(), (int32)SlotType);
-        return;
+        return false;
     }
 
-    // Store old item for event broadcasting
-    USHIItemData* OldItem = TargetSlot->ItemData;
-
     // ENHANCED: Shield dependency validation
-    if (SlotType == ESHIEquipmentSlot::Kalkan)
+    if (SlotType == ESHIEquipmentSlot::Kalkan && !ValidateShieldDependency(ItemData))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Shield dependency validation failed"));
+        return false; // Block shield equipping
+    }
+
+    // A two-handed weapon and a shield can't be held together
+    if (IsWeaponSlot(SlotType) && ItemData->HasTrait(ESHIItemTraits::IkiElli) && !IsSlotEmpty(ESHIEquipmentSlot::Kalkan))
     {
-        if (!ValidateShieldDependency(ItemData))
+        UE_LOG(LogTemp, Warning, TEXT("Cannot equip two-handed %s - shield equipped"), *ItemData->ItemName.ToString());
+        if (GEngine)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Shield dependency validation failed"));
-            return; // Block shield equipping
+            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, 
+                TEXT("İki elli silah için önce kalkanı çıkarmalısın!"));
         }
+        return false;
     }
 
+    return true;
+}
+
+void USHIEquipmentComponent::SetSlotItem(ESHIEquipmentSlot SlotType, USHIItemData* ItemData, int32 Quantity)
+{
+    FSHIEquipmentSlot* TargetSlot = EquipmentState.GetSlotByType(SlotType);
+
+    // Store old item for event broadcasting
+    USHIItemData* OldItem = TargetSlot->IsEmpty() ? nullptr : TargetSlot->ItemData;
+
     // Equip the new item
     TargetSlot->ItemData = ItemData;
     TargetSlot->Quantity = Quantity;
@@ -83,36 +312,75 @@ void USHIEquipmentComponent::Server_EquipItem_Implementation(ESHIEquipmentSlot S
 
 void USHIEquipmentComponent::Server_UnequipItem_Implementation(ESHIEquipmentSlot SlotType)
 {
+    UnequipToInventory(SlotType, INDEX_NONE);
+}
+
+void USHIEquipmentComponent::Server_UnequipToInventory_Implementation(ESHIEquipmentSlot SlotType, int32 InventorySlot)
+{
+    UnequipToInventory(SlotType, InventorySlot);
+}
+
+bool USHIEquipmentComponent::UnequipToInventory(ESHIEquipmentSlot SlotType, int32 InventorySlot)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return false;
+    }
+
     if (SlotType == ESHIEquipmentSlot::None)
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot unequip from invalid slot"));
-        return;
+        return false;
     }
 
-    FSHIEquipmentSlot* TargetSlot = EquipmentState.GetSlotByType(SlotType);
+    const FSHIEquipmentSlot* TargetSlot = EquipmentState.GetSlotByType(SlotType);
     if (!TargetSlot || TargetSlot->IsEmpty())
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot unequip from empty slot %d"), (int32)SlotType);
-        return;
+        return false;
     }
 
-    USHIItemData* OldItem = TargetSlot->ItemData;
-    
-    // Store sword info before unequipping
-    bool WasSwordUnequipped = false;
-    if (SlotType == ESHIEquipmentSlot::Silah1 || SlotType == ESHIEquipmentSlot::Silah2)
+    // The item goes back to the inventory - if it does not fit it stays equipped
+    USHIInventoryComponent* Inventory = GetOwnerInventory();
+    if (!Inventory)
     {
-        if (OldItem && OldItem->ItemType == ESHIItemType::Silah)
+        UE_LOG(LogTemp, Warning, TEXT("Cannot unequip slot %d - owner has no inventory"), (int32)SlotType);
+        return false;
+    }
+
+    TArray<FSHIInventoryOp> Operations;
+    FSHIInventoryOp& GiveBack = Operations.AddDefaulted_GetRef();
+    GiveBack.OpType = ESHIInventoryOpType::Add;
+    GiveBack.ItemData = TargetSlot->ItemData;
+    GiveBack.Quantity = TargetSlot->Quantity;
+    GiveBack.SlotIndex = InventorySlot;
+
+    // Taking off the last sword returns the shield too - both fit or neither moves
+    const bool bReturnShield = AddShieldReturnIfNeeded(SlotType, nullptr, Operations);
+
+    if (!Inventory->ApplyBatch(Operations))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot unequip %s - no room in the inventory"), *TargetSlot->ItemData->ItemName.ToString());
+        if (GEngine)
         {
-            FString ItemName = OldItem->ItemName.ToString();
-            if (ItemName.Contains(TEXT("Kılıç")) || ItemName.Contains(TEXT("Sword")))
-            {
-                WasSwordUnequipped = true;
-                UE_LOG(LogTemp, Log, TEXT("Sword being unequipped: %s"), *ItemName);
-            }
+            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("Envanter dolu - eşya çıkarılamadı"));
         }
+        return false;
     }
 
+    ClearSlotItem(SlotType);
+    if (bReturnShield)
+    {
+        ClearShieldWithoutSword();
+    }
+    return true;
+}
+
+void USHIEquipmentComponent::ClearSlotItem(ESHIEquipmentSlot SlotType)
+{
+    FSHIEquipmentSlot* TargetSlot = EquipmentState.GetSlotByType(SlotType);
+    USHIItemData* OldItem = TargetSlot->ItemData;
+
     // Clear the slot
     TargetSlot->Clear();
 
@@ -134,24 +402,6 @@ void USHIEquipmentComponent::Server_UnequipItem_Implementation(ESHIEquipmentSlot
         BroadcastActiveWeaponChange();
     }
 
-    // ENHANCED: Check if we need to auto-unequip shield after sword removal
-    if (WasSwordUnequipped)
-    {
-        // Small delay to ensure unequip completed first
-        if (GetWorld())
-        {
-            GetWorld()->GetTimerManager().SetTimerForNextTick([this]()
-            {
-                ValidateShieldEquipment();
-            });
-        }
-    }
-    else
-    {
-        // Regular validation for other items
-        ValidateShieldEquipment();
-    }
-
     BroadcastEquipmentChange(SlotType, nullptr, OldItem);
 
     UE_LOG(LogTemp, Log, TEXT("Unequipped item from slot %d"), (int32)SlotType);
@@ -227,14 +477,12 @@ TArray<FSHIStatModifier> USHIEquipmentComponent::GetAllEquipmentStatBonuses() co
     TArray<FSHIStatModifier> AllBonuses;
 
     // Check all equipment slots
-    TArray<ESHIEquipmentSlot> AllSlots = GetAllEquipmentSlots();
-    
-    for (ESHIEquipmentSlot SlotType : AllSlots)
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
     {
-        const FSHIEquipmentSlot* Slot = EquipmentState.GetSlotByType(SlotType);
-        if (Slot && !Slot->IsEmpty() && Slot->ItemData)
+        const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+        if (!Slot.IsEmpty())
         {
-            AllBonuses.Append(Slot->ItemData->StatBonuses);
+            AllBonuses.Append(Slot.ItemData->StatBonuses);
         }
     }
 
@@ -261,44 +509,99 @@ bool USHIEquipmentComponent::IsValidEquipmentSlot(ESHIEquipmentSlot SlotType, US
 
 TArray<ESHIEquipmentSlot> USHIEquipmentComponent::GetAllEquipmentSlots() const
 {
-    return {
-        ESHIEquipmentSlot::Kask,
-        ESHIEquipmentSlot::GoguslukZirhi,
-        ESHIEquipmentSlot::Kalkan,
-        ESHIEquipmentSlot::Silah1,
-        ESHIEquipmentSlot::Silah2,
-        ESHIEquipmentSlot::Kolye,
-        ESHIEquipmentSlot::Yuzuk,
-        ESHIEquipmentSlot::Kupe
-    };
+    TArray<ESHIEquipmentSlot> AllSlots;
+    AllSlots.Reserve(FSHIEquipmentState::NumSlots - 1);
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+    {
+        AllSlots.Add(static_cast<ESHIEquipmentSlot>(i));
+    }
+    return AllSlots;
 }
 
 void USHIEquipmentComponent::OnRep_EquipmentState()
 {
-    UE_LOG(LogTemp, Log, TEXT("Equipment state replicated"));
-    
-    // Broadcast all equipment changes for UI updates
-    TArray<ESHIEquipmentSlot> AllSlots = GetAllEquipmentSlots();
+    const uint16 ChangedMask = EquipmentState.ReceivedChangeMask;
+    EquipmentState.ReceivedChangeMask = 0;
+
+    UE_LOG(LogTemp, Log, TEXT("Equipment state replicated (changed mask 0x%x)"), ChangedMask);
     
-    for (ESHIEquipmentSlot SlotType : AllSlots)
+    // Broadcast only the slots that changed, with the item they held before
+    USHIItemData* OldItems[FSHIEquipmentState::NumSlots];
+    FMemory::Memcpy(OldItems, LastReplicatedItems, sizeof(OldItems));
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
     {
-        const FSHIEquipmentSlot* Slot = EquipmentState.GetSlotByType(SlotType);
-        if (Slot)
+        if (ChangedMask & (1 << i))
         {
-            OnEquipmentChanged.Broadcast(SlotType, Slot->ItemData, nullptr);
+            const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+            LastReplicatedItems[i] = Slot.IsEmpty() ? nullptr : Slot.ItemData;
         }
     }
     
-    OnActiveWeaponChanged.Broadcast(EquipmentState.ActiveWeaponSlot);
+    BroadcastEquipmentSet(ChangedMask, OldItems);
 }
 
 // Old ValidateShieldEquipment removed - using enhanced version below
 
 void USHIEquipmentComponent::BroadcastEquipmentChange(ESHIEquipmentSlot SlotType, USHIItemData* NewItem, USHIItemData* OldItem)
 {
+    UpdateEquipmentStatTotal(NewItem, OldItem);
     OnEquipmentChanged.Broadcast(SlotType, NewItem, OldItem);
 }
 
+void USHIEquipmentComponent::BroadcastEquipmentSet(uint16 ChangedMask, USHIItemData* const* OldItems)
+{
+    if (ChangedMask == 0)
+    {
+        return;
+    }
+
+    // Totals first, so every listener already sees the final set
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+    {
+        if (ChangedMask & (1 << i))
+        {
+            const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+            UpdateEquipmentStatTotal(Slot.IsEmpty() ? nullptr : Slot.ItemData, OldItems[i]);
+        }
+    }
+
+    {
+        TGuardValue<bool> BroadcastGuard(bBroadcastingEquipmentSet, true);
+        for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+        {
+            if (ChangedMask & (1 << i))
+            {
+                const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+                OnEquipmentChanged.Broadcast(static_cast<ESHIEquipmentSlot>(i), Slot.IsEmpty() ? nullptr : Slot.ItemData, OldItems[i]);
+            }
+        }
+
+        if (ChangedMask & FSHIEquipmentState::ActiveWeaponBit)
+        {
+            OnActiveWeaponChanged.Broadcast(EquipmentState.ActiveWeaponSlot);
+        }
+    }
+
+    OnEquipmentSetChanged.Broadcast();
+}
+
+void USHIEquipmentComponent::UpdateEquipmentStatTotal(USHIItemData* NewItem, USHIItemData* OldItem)
+{
+    if (NewItem == OldItem)
+    {
+        return; // Quantity only change
+    }
+
+    if (OldItem)
+    {
+        EquipmentStatTotal -= OldItem->GetStatVector();
+    }
+    if (NewItem)
+    {
+        EquipmentStatTotal += NewItem->GetStatVector();
+    }
+}
+
 void USHIEquipmentComponent::BroadcastActiveWeaponChange()
 {
     OnActiveWeaponChanged.Broadcast(EquipmentState.ActiveWeaponSlot);
@@ -314,7 +617,10 @@ bool USHIEquipmentComponent::IsWeaponSlot(ESHIEquipmentSlot SlotType) const
 bool USHIEquipmentComponent::IsArmorSlot(ESHIEquipmentSlot SlotType) const
 {
     return SlotType == ESHIEquipmentSlot::Kask || 
-           SlotType == ESHIEquipmentSlot::GoguslukZirhi;
+           SlotType == ESHIEquipmentSlot::GoguslukZirhi ||
+           SlotType == ESHIEquipmentSlot::Eldiven ||
+           SlotType == ESHIEquipmentSlot::Pantolon ||
+           SlotType == ESHIEquipmentSlot::Ayakkabi;
 }
 
 bool USHIEquipmentComponent::IsAccessorySlot(ESHIEquipmentSlot SlotType) const
@@ -329,21 +635,19 @@ void USHIEquipmentComponent::DebugPrintEquipment() const
     UE_LOG(LogTemp, Warning, TEXT("=== EQUIPMENT DEBUG ==="));
     UE_LOG(LogTemp, Warning, TEXT("Active Weapon Slot: %d"), (int32)EquipmentState.ActiveWeaponSlot);
     
-    TArray<ESHIEquipmentSlot> AllSlots = GetAllEquipmentSlots();
-    
-    for (ESHIEquipmentSlot SlotType : AllSlots)
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
     {
-        const FSHIEquipmentSlot* Slot = EquipmentState.GetSlotByType(SlotType);
-        if (Slot && !Slot->IsEmpty())
+        const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+        if (!Slot.IsEmpty())
         {
             UE_LOG(LogTemp, Warning, TEXT("Slot %d: %s x%d"), 
-                   (int32)SlotType, 
-                   *Slot->ItemData->ItemName.ToString(), 
-                   Slot->Quantity);
+                   i, 
+                   *Slot.ItemData->ItemName.ToString(), 
+                   Slot.Quantity);
         }
         else
         {
-            UE_LOG(LogTemp, Log, TEXT("Slot %d: Empty"), (int32)SlotType);
+            UE_LOG(LogTemp, Log, TEXT("Slot %d: Empty"), i);
         }
     }
     UE_LOG(LogTemp, Warning, TEXT("=== END EQUIPMENT DEBUG ==="));
@@ -352,11 +656,9 @@ void USHIEquipmentComponent::DebugPrintEquipment() const
 int32 USHIEquipmentComponent::GetEquippedItemCount() const
 {
     int32 Count = 0;
-    TArray<ESHIEquipmentSlot> AllSlots = GetAllEquipmentSlots();
-    
-    for (ESHIEquipmentSlot SlotType : AllSlots)
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
     {
-        if (!IsSlotEmpty(SlotType))
+        if (!EquipmentState.Slots[i].IsEmpty())
         {
             Count++;
         }
@@ -379,25 +681,13 @@ bool USHIEquipmentComponent::HasValidSwordEquipped() const
         const FSHIEquipmentSlot* Slot = EquipmentState.GetSlotByType(WeaponSlot);
         if (Slot && !Slot->IsEmpty() && Slot->ItemData)
         {
-            // Check if item is a sword (Kılıç) - enhanced detection
-            if (Slot->ItemData->ItemType == ESHIItemType::Silah)
+            // Check if item is a sword (Kılıç) - shields never carry the sword trait
+            if (Slot->ItemData->ItemType == ESHIItemType::Silah && 
+                Slot->ItemData->HasTrait(ESHIItemTraits::Kilic) &&
+                !Slot->ItemData->HasTrait(ESHIItemTraits::Kalkan))
             {
-                FString ItemName = Slot->ItemData->ItemName.ToString();
-                // Enhanced sword detection - multiple variations + encoding fix
-                if (ItemName.Contains(TEXT("Kılıç")) || ItemName.Contains(TEXT("Sword")) ||
-                    ItemName.Contains(TEXT("Kilič")) ||  // Alternative spelling
-                    ItemName.Contains(TEXT("Saber")) ||
-                    ItemName.Contains(TEXT("Sabre")) ||
-                    ItemName.Contains(TEXT("Test K")) ||  // Encoding-safe detection
-                    ItemName.Contains(TEXT("Kilic")))     // ASCII version
-                {
-                    // Make sure it's NOT a shield being misidentified
-                    if (!ItemName.Contains(TEXT("Kalkan")) && !ItemName.Contains(TEXT("Shield")))
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("✅ Valid sword found: %s in slot %d"), *ItemName, (int32)WeaponSlot);
-                        return true;
-                    }
-                }
+                UE_LOG(LogTemp, Verbose, TEXT("Valid sword found: %s in slot %d"), *Slot->ItemData->ItemName.ToString(), (int32)WeaponSlot);
+                return true;
             }
         }
     }
@@ -414,23 +704,30 @@ USHIItemData* USHIEquipmentComponent::GetEquippedSword() const
         const FSHIEquipmentSlot* Slot = EquipmentState.GetSlotByType(WeaponSlot);
         if (Slot && !Slot->IsEmpty() && Slot->ItemData)
         {
-            if (Slot->ItemData->ItemType == ESHIItemType::Silah)
+            if (Slot->ItemData->ItemType == ESHIItemType::Silah && 
+                Slot->ItemData->HasTrait(ESHIItemTraits::Kilic) &&
+                !Slot->ItemData->HasTrait(ESHIItemTraits::Kalkan))
             {
-                FString ItemName = Slot->ItemData->ItemName.ToString();
-                if (ItemName.Contains(TEXT("Kılıç")) || ItemName.Contains(TEXT("Sword")) ||
-                    ItemName.Contains(TEXT("Test K")) || ItemName.Contains(TEXT("Kilic")))
-                {
-                    if (!ItemName.Contains(TEXT("Kalkan")) && !ItemName.Contains(TEXT("Shield")))
-                    {
-                        return Slot->ItemData;
-                    }
-                }
+                return Slot->ItemData;
             }
         }
     }
     return nullptr;
 }
 
+bool USHIEquipmentComponent::HasTwoHandedWeaponEquipped() const
+{
+    for (ESHIEquipmentSlot WeaponSlot : {ESHIEquipmentSlot::Silah1, ESHIEquipmentSlot::Silah2})
+    {
+        const FSHIEquipmentSlot* Slot = EquipmentState.GetSlotByType(WeaponSlot);
+        if (Slot && !Slot->IsEmpty() && Slot->ItemData && Slot->ItemData->HasTrait(ESHIItemTraits::IkiElli))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void USHIEquipmentComponent::ValidateShieldEquipment()
 {
     // Check if shield is equipped but no sword available
@@ -458,8 +755,11 @@ bool USHIEquipmentComponent::AutoUnequipShieldIfNeeded()
         UE_LOG(LogTemp, Log, TEXT("Auto-unequipping shield: %s (no sword equipped)"), 
                *ShieldItem->ItemName.ToString());
         
-        // Unequip shield
-        Server_UnequipItem(ESHIEquipmentSlot::Kalkan);
+        // Unequip shield back into the inventory - with a full inventory it stays on
+        if (!UnequipToInventory(ESHIEquipmentSlot::Kalkan, INDEX_NONE))
+        {
+            return false;
+        }
         
         // Show user feedback
         if (GEngine)
@@ -474,6 +774,48 @@ bool USHIEquipmentComponent::AutoUnequipShieldIfNeeded()
     return false;
 }
 
+bool USHIEquipmentComponent::AddShieldReturnIfNeeded(ESHIEquipmentSlot WeaponSlot, const USHIItemData* NewItem, TArray<FSHIInventoryOp>& Operations) const
+{
+    const FSHIEquipmentSlot* ShieldSlot = EquipmentState.GetSlotByType(ESHIEquipmentSlot::Kalkan);
+    if (!IsWeaponSlot(WeaponSlot) || !ShieldSlot || ShieldSlot->IsEmpty())
+    {
+        return false;
+    }
+
+    // Look at both weapon slots as they will be once WeaponSlot holds NewItem
+    for (ESHIEquipmentSlot Slot : {ESHIEquipmentSlot::Silah1, ESHIEquipmentSlot::Silah2})
+    {
+        const USHIItemData* Item = Slot == WeaponSlot ? NewItem : EquipmentState.GetSlotByType(Slot)->ItemData;
+        if (Item && Item->ItemType == ESHIItemType::Silah &&
+            Item->HasTrait(ESHIItemTraits::Kilic) &&
+            !Item->HasTrait(ESHIItemTraits::Kalkan))
+        {
+            return false;
+        }
+    }
+
+    FSHIInventoryOp& ShieldBack = Operations.AddDefaulted_GetRef();
+    ShieldBack.OpType = ESHIInventoryOpType::Add;
+    ShieldBack.ItemData = ShieldSlot->ItemData;
+    ShieldBack.Quantity = ShieldSlot->Quantity;
+    ShieldBack.SlotIndex = INDEX_NONE;
+    return true;
+}
+
+void USHIEquipmentComponent::ClearShieldWithoutSword()
+{
+    USHIItemData* ShieldItem = EquipmentState.GetSlotByType(ESHIEquipmentSlot::Kalkan)->ItemData;
+    ClearSlotItem(ESHIEquipmentSlot::Kalkan);
+
+    UE_LOG(LogTemp, Log, TEXT("Auto-unequipped shield: %s (no sword equipped)"), *ShieldItem->ItemName.ToString());
+    if (GEngine)
+    {
+        FString ShieldMessage = FString::Printf(TEXT("🛡️ %s otomatik çıkarıldı - Kılıç gerekli!"), 
+                                               *ShieldItem->ItemName.ToString());
+        GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Orange, ShieldMessage);
+    }
+}
+
 bool USHIEquipmentComponent::ValidateShieldDependency(USHIItemData* ShieldItem) const
 {
     if (!ShieldItem)
@@ -482,16 +824,25 @@ bool USHIEquipmentComponent::ValidateShieldDependency(USHIItemData* ShieldItem)
     }
     
     // Check if this is a shield item
-    FString ItemName = ShieldItem->ItemName.ToString();
-    bool IsShield = ItemName.Contains(TEXT("Kalkan")) || ItemName.Contains(TEXT("Shield")) ||
-                    ItemName.Contains(TEXT("Buckler"));
-    
-    if (IsShield)
+    if (ShieldItem->HasTrait(ESHIItemTraits::Kalkan))
     {
+        // Both hands are on a two-handed weapon
+        if (HasTwoHandedWeaponEquipped())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Cannot equip shield %s - two-handed weapon equipped"), *ShieldItem->ItemName.ToString());
+            if (GEngine)
+            {
+                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, 
+                    TEXT("🛡️ İki elli silahla kalkan takılamaz!"));
+            }
+            return false;
+        }
+
+
         // Shield requires sword
         if (!HasValidSwordEquipped())
         {
-            UE_LOG(LogTemp, Warning, TEXT("Cannot equip shield %s - no sword equipped"), *ItemName);
+            UE_LOG(LogTemp, Warning, TEXT("Cannot equip shield %s - no sword equipped"), *ShieldItem->ItemName.ToString());
             if (GEngine)
             {
                 GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, 
@@ -508,4 +859,207 @@ bool USHIEquipmentComponent::ValidateShieldDependency(USHIItemData* ShieldItem)
 bool USHIEquipmentComponent::HasSwordEquipped() const
 {
     return HasValidSwordEquipped();
+}
+
+USHIInventoryComponent* USHIEquipmentComponent::GetOwnerInventory() const
+{
+    return GetOwner() ? GetOwner()->FindComponentByClass<USHIInventoryComponent>() : nullptr;
+}
+
+USHIItemData* USHIEquipmentComponent::GetLoadoutItem(int32 LoadoutIndex, ESHIEquipmentSlot SlotType) const
+{
+    if (!Loadouts.IsValidIndex(LoadoutIndex) || !FSHIEquipmentState::IsValidSlot(SlotType))
+    {
+        return nullptr;
+    }
+    return Loadouts[LoadoutIndex].Items[(uint8)SlotType];
+}
+
+void USHIEquipmentComponent::Server_SaveLoadout_Implementation(int32 LoadoutIndex, FName LoadoutName)
+{
+    if (LoadoutIndex < 0 || LoadoutIndex >= MaxLoadouts)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid loadout index %d (max %d)"), LoadoutIndex, MaxLoadouts);
+        return;
+    }
+
+    if (LoadoutIndex >= Loadouts.Num())
+    {
+        Loadouts.SetNum(LoadoutIndex + 1);
+    }
+
+    FSHIEquipmentLoadout& Loadout = Loadouts[LoadoutIndex];
+    Loadout.LoadoutName = LoadoutName;
+    Loadout.ActiveWeaponSlot = EquipmentState.ActiveWeaponSlot;
+    Loadout.bSaved = true;
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+    {
+        const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+        Loadout.Items[i] = Slot.IsEmpty() ? nullptr : Slot.ItemData;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Saved loadout %d (%s) with %d items"), LoadoutIndex, *LoadoutName.ToString(), GetEquippedItemCount());
+}
+
+void USHIEquipmentComponent::Server_ApplyLoadout_Implementation(int32 LoadoutIndex)
+{
+    ApplyLoadout(LoadoutIndex);
+}
+
+bool USHIEquipmentComponent::IsValidLoadout(const FSHIEquipmentLoadout& Loadout) const
+{
+    bool bHasSword = false;
+    bool bHasTwoHanded = false;
+    for (ESHIEquipmentSlot WeaponSlot : {ESHIEquipmentSlot::Silah1, ESHIEquipmentSlot::Silah2})
+    {
+        const USHIItemData* Weapon = Loadout.Items[(uint8)WeaponSlot];
+        bHasSword |= Weapon && Weapon->HasTrait(ESHIItemTraits::Kilic) && !Weapon->HasTrait(ESHIItemTraits::Kalkan);
+        bHasTwoHanded |= Weapon && Weapon->HasTrait(ESHIItemTraits::IkiElli);
+    }
+
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+    {
+        USHIItemData* Item = Loadout.Items[i];
+        const ESHIEquipmentSlot SlotType = static_cast<ESHIEquipmentSlot>(i);
+        if (!Item)
+        {
+            continue;
+        }
+        if (!IsValidEquipmentSlot(SlotType, Item))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Loadout item %s cannot go in slot %d"), *Item->ItemName.ToString(), i);
+            return false;
+        }
+        if (Item->HasTrait(ESHIItemTraits::Kalkan) && !bHasSword)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Loadout has shield %s but no sword"), *Item->ItemName.ToString());
+            return false;
+        }
+        if (Item->HasTrait(ESHIItemTraits::Kalkan) && bHasTwoHanded)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Loadout has shield %s next to a two-handed weapon"), *Item->ItemName.ToString());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool USHIEquipmentComponent::ApplyLoadout(int32 LoadoutIndex)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return false;
+    }
+
+    if (!Loadouts.IsValidIndex(LoadoutIndex) || !Loadouts[LoadoutIndex].bSaved)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Loadout %d has not been saved"), LoadoutIndex);
+        return false;
+    }
+
+    const FSHIEquipmentLoadout& Loadout = Loadouts[LoadoutIndex];
+    if (!IsValidLoadout(Loadout))
+    {
+        return false;
+    }
+
+    USHIInventoryComponent* Inventory = GetOwnerInventory();
+    if (!Inventory)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot apply loadout %d - owner has no inventory"), LoadoutIndex);
+        return false;
+    }
+
+    // Net item flow: positive = has to come out of the inventory, negative = goes back into it.
+    // Items that only move between equipment slots cancel out.
+    TMap<USHIItemData*, int32, TInlineSetAllocator<16>> NetFromInventory;
+    uint16 ChangedMask = 0;
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+    {
+        const FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+        USHIItemData* CurrentItem = Slot.IsEmpty() ? nullptr : Slot.ItemData;
+        USHIItemData* TargetItem = Loadout.Items[i];
+        if (CurrentItem == TargetItem)
+        {
+            continue;
+        }
+
+        ChangedMask |= 1 << i;
+        if (CurrentItem)
+        {
+            NetFromInventory.FindOrAdd(CurrentItem) -= Slot.Quantity;
+        }
+        if (TargetItem)
+        {
+            NetFromInventory.FindOrAdd(TargetItem) += 1;
+        }
+    }
+
+    // Removals first so they free the space the returned items need
+    TArray<FSHIInventoryOp> Operations;
+    for (const TPair<USHIItemData*, int32>& Flow : NetFromInventory)
+    {
+        if (Flow.Value > 0)
+        {
+            FSHIInventoryOp& Operation = Operations.AddDefaulted_GetRef();
+            Operation.OpType = ESHIInventoryOpType::Remove;
+            Operation.ItemData = Flow.Key;
+            Operation.Quantity = Flow.Value;
+        }
+    }
+    for (const TPair<USHIItemData*, int32>& Flow : NetFromInventory)
+    {
+        if (Flow.Value < 0)
+        {
+            FSHIInventoryOp& Operation = Operations.AddDefaulted_GetRef();
+            Operation.OpType = ESHIInventoryOpType::Add;
+            Operation.ItemData = Flow.Key;
+            Operation.Quantity = -Flow.Value;
+        }
+    }
+
+    if (Operations.Num() > 0 && !Inventory->ApplyBatch(Operations))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Loadout %d needs items that are missing or returns more than fits - nothing changed"), LoadoutIndex);
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("Ekipman seti uygulanamadı - eşyalar eksik veya envanter dolu"));
+        }
+        return false;
+    }
+
+    // Inventory side committed - write every slot, events go out once at the end
+    USHIItemData* OldItems[FSHIEquipmentState::NumSlots] = {};
+    for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+    {
+        FSHIEquipmentSlot& Slot = EquipmentState.Slots[i];
+        OldItems[i] = Slot.IsEmpty() ? nullptr : Slot.ItemData;
+        if (ChangedMask & (1 << i))
+        {
+            Slot.ItemData = Loadout.Items[i];
+            Slot.Quantity = Loadout.Items[i] ? 1 : 0;
+        }
+    }
+
+    ESHIEquipmentSlot NewActiveWeapon = Loadout.ActiveWeaponSlot;
+    if (!IsWeaponSlot(NewActiveWeapon) || IsSlotEmpty(NewActiveWeapon))
+    {
+        NewActiveWeapon = !IsSlotEmpty(ESHIEquipmentSlot::Silah1) || IsSlotEmpty(ESHIEquipmentSlot::Silah2) ? 
+                          ESHIEquipmentSlot::Silah1 : ESHIEquipmentSlot::Silah2;
+    }
+    if (NewActiveWeapon != EquipmentState.ActiveWeaponSlot)
+    {
+        EquipmentState.ActiveWeaponSlot = NewActiveWeapon;
+        ChangedMask |= FSHIEquipmentState::ActiveWeaponBit;
+    }
+
+    BroadcastEquipmentSet(ChangedMask, OldItems);
+
+    UE_LOG(LogTemp, Log, TEXT("Applied loadout %d (%s)"), LoadoutIndex, *Loadout.LoadoutName.ToString());
+    if (GEngine)
+    {
+        FString LoadoutText = FString::Printf(TEXT("Ekipman seti: %s"), *Loadout.LoadoutName.ToString());
+        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, LoadoutText);
+    }
+    return true;
 }
\ No newline at end of file
@@ -5,94 +5,85 @@
 #include "Data/SHIItemData.h"
 #include "SHIEquipmentComponent.generated.h"
 
-// Equipment state for network replication (TMap yerine individual properties)
+class USHIInventoryComponent;
+struct FSHIInventoryOp;
+
+// Equipment state for network replication - one slot per ESHIEquipmentSlot
 USTRUCT(BlueprintType)
 struct FSHIEquipmentState
 {
     GENERATED_BODY()
 
-    // Individual equipment slots for network replication
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot KaskSlot;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot GoguslukZirhiSlot;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot KalkanSlot;
+    static constexpr int32 NumSlots = (int32)ESHIEquipmentSlot::Max;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot Silah1Slot;
+    // Bit NumSlots of a change mask = active weapon slot
+    static constexpr uint16 ActiveWeaponBit = 1 << NumSlots;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot Silah2Slot;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot KolyeSlot;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot YuzukSlot;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
-    FSHIEquipmentSlot KupeSlot;
-    
+    // Indexed by ESHIEquipmentSlot, index 0 (None) is never used
+    UPROPERTY(EditAnywhere, Category = "Equipment")
+    FSHIEquipmentSlot Slots[(uint8)ESHIEquipmentSlot::Max];
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
     ESHIEquipmentSlot ActiveWeaponSlot = ESHIEquipmentSlot::Silah1;
 
-    FSHIEquipmentState()
+    // Slots received since the last OnRep (client only, not replicated)
+    uint16 ReceivedChangeMask = 0;
+
+    static bool IsValidSlot(ESHIEquipmentSlot SlotType)
     {
-        ActiveWeaponSlot = ESHIEquipmentSlot::Silah1;
-        
-        // All slots start empty (default constructor handles this)
-        KaskSlot = FSHIEquipmentSlot();
-        GoguslukZirhiSlot = FSHIEquipmentSlot();
-        KalkanSlot = FSHIEquipmentSlot();
-        Silah1Slot = FSHIEquipmentSlot();
-        Silah2Slot = FSHIEquipmentSlot();
-        KolyeSlot = FSHIEquipmentSlot();
-        YuzukSlot = FSHIEquipmentSlot();
-        KupeSlot = FSHIEquipmentSlot();
+        return SlotType > ESHIEquipmentSlot::None && SlotType < ESHIEquipmentSlot::Max;
     }
 
     // Helper function to get slot by type
     FSHIEquipmentSlot* GetSlotByType(ESHIEquipmentSlot SlotType)
     {
-        switch (SlotType)
-        {
-            case ESHIEquipmentSlot::Kask: return &KaskSlot;
-            case ESHIEquipmentSlot::GoguslukZirhi: return &GoguslukZirhiSlot;
-            case ESHIEquipmentSlot::Kalkan: return &KalkanSlot;
-            case ESHIEquipmentSlot::Silah1: return &Silah1Slot;
-            case ESHIEquipmentSlot::Silah2: return &Silah2Slot;
-            case ESHIEquipmentSlot::Kolye: return &KolyeSlot;
-            case ESHIEquipmentSlot::Yuzuk: return &YuzukSlot;
-            case ESHIEquipmentSlot::Kupe: return &KupeSlot;
-            default: return nullptr;
-        }
+        return IsValidSlot(SlotType) ? &Slots[(uint8)SlotType] : nullptr;
     }
 
     // Const version
     const FSHIEquipmentSlot* GetSlotByType(ESHIEquipmentSlot SlotType) const
     {
-        switch (SlotType)
-        {
-            case ESHIEquipmentSlot::Kask: return &KaskSlot;
-            case ESHIEquipmentSlot::GoguslukZirhi: return &GoguslukZirhiSlot;
-            case ESHIEquipmentSlot::Kalkan: return &KalkanSlot;
-            case ESHIEquipmentSlot::Silah1: return &Silah1Slot;
-            case ESHIEquipmentSlot::Silah2: return &Silah2Slot;
-            case ESHIEquipmentSlot::Kolye: return &KolyeSlot;
-            case ESHIEquipmentSlot::Yuzuk: return &YuzukSlot;
-            case ESHIEquipmentSlot::Kupe: return &KupeSlot;
-            default: return nullptr;
-        }
+        return IsValidSlot(SlotType) ? &Slots[(uint8)SlotType] : nullptr;
     }
+
+    // Sends a slot change mask plus only the slots that changed since the last send
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSHIEquipmentState> : public TStructOpsTypeTraitsBase2<FSHIEquipmentState>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true
+    };
+};
+
+// Saved equipment preset (PvE / PvP gear), swapped in with a single RPC
+USTRUCT(BlueprintType)
+struct FSHIEquipmentLoadout
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
+    FName LoadoutName;
+
+    // Indexed by ESHIEquipmentSlot, nullptr = slot stays empty
+    UPROPERTY(EditAnywhere, Category = "Equipment")
+    USHIItemData* Items[(uint8)ESHIEquipmentSlot::Max] = {};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Equipment")
+    ESHIEquipmentSlot ActiveWeaponSlot = ESHIEquipmentSlot::Silah1;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+    bool bSaved = false;
 };
 
 // Equipment change event
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnEquipmentChanged, ESHIEquipmentSlot, SlotType, USHIItemData*, NewItem, USHIItemData*, OldItem);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActiveWeaponChanged, ESHIEquipmentSlot, NewActiveWeapon);
+// Fired once after a batch of slot changes (loadout swap, replication update) - per slot events fire just before
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEquipmentSetChanged);
 
 UCLASS(ClassGroup=(SHI), meta=(BlueprintSpawnableComponent))
 class STILLHEREISTANBUL_API USHIEquipmentComponent : public UActorComponent
@@ -111,16 +102,61 @@ protected:
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 public:
-    // Equipment management functions
+    // Equipment management functions - equipped items always come from and go back to the owner's inventory
+    // Equips one item from the first inventory stack of ItemData (a slot holds one item)
     UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment")
-    void Server_EquipItem(ESHIEquipmentSlot SlotType, USHIItemData* ItemData, int32 Quantity = 1);
+    void Server_EquipItem(ESHIEquipmentSlot SlotType, USHIItemData* ItemData);
 
     UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment")
     void Server_UnequipItem(ESHIEquipmentSlot SlotType);
 
+    // Moves one item from an inventory slot into SlotType, the replaced item goes back to the inventory
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment")
+    void Server_EquipFromInventory(int32 InventorySlot, ESHIEquipmentSlot SlotType);
+
+    // Moves the equipped item into an inventory slot, -1 = wherever it fits
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment")
+    void Server_UnequipToInventory(ESHIEquipmentSlot SlotType, int32 InventorySlot = -1);
+
+    // Server side versions, return false if nothing moved
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment")
+    bool EquipFromInventory(int32 InventorySlot, ESHIEquipmentSlot SlotType);
+
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment")
+    bool UnequipToInventory(ESHIEquipmentSlot SlotType, int32 InventorySlot = -1);
+
+    // Test / debug only - equips an item that is not in the inventory, a replaced item is discarded
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment Debug")
+    bool ForceEquipItem(ESHIEquipmentSlot SlotType, USHIItemData* ItemData, int32 Quantity = 1);
+
     UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment")
     void Server_SetActiveWeapon(ESHIEquipmentSlot WeaponSlot);
 
+    // Loadouts
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Equipment Loadouts", meta = (ClampMin = "1"))
+    int32 MaxLoadouts = 4;
+
+    // Stores what is equipped right now under LoadoutIndex
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment Loadouts")
+    void Server_SaveLoadout(int32 LoadoutIndex, FName LoadoutName);
+
+    // Swaps to a saved loadout - items move between inventory and equipment in one step, or nothing changes
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Equipment Loadouts")
+    void Server_ApplyLoadout(int32 LoadoutIndex);
+
+    // Server side version, returns false if the loadout could not be applied
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment Loadouts")
+    bool ApplyLoadout(int32 LoadoutIndex);
+
+    UFUNCTION(BlueprintPure, Category = "Equipment Loadouts")
+    const TArray<FSHIEquipmentLoadout>& GetLoadouts() const { return Loadouts; }
+
+    UFUNCTION(BlueprintPure, Category = "Equipment Loadouts")
+    USHIItemData* GetLoadoutItem(int32 LoadoutIndex, ESHIEquipmentSlot SlotType) const;
+
+    // True while a batch of slot changes is being broadcast - listeners can wait for OnEquipmentSetChanged
+    bool IsBroadcastingEquipmentSet() const { return bBroadcastingEquipmentSet; }
+
     // Equipment query functions
     UFUNCTION(BlueprintPure, Category = "Equipment")
     FSHIEquipmentSlot GetEquippedItem(ESHIEquipmentSlot SlotType) const;
@@ -134,12 +170,17 @@ public:
     UFUNCTION(BlueprintPure, Category = "Equipment")
     ESHIEquipmentSlot GetActiveWeaponSlot() const { return EquipmentState.ActiveWeaponSlot; }
 
+    const FSHIEquipmentState& GetEquipmentState() const { return EquipmentState; }
+
     UFUNCTION(BlueprintPure, Category = "Equipment")
     bool CanEquipItem(USHIItemData* ItemData, ESHIEquipmentSlot SlotType) const;
 
     UFUNCTION(BlueprintPure, Category = "Equipment")
     TArray<FSHIStatModifier> GetAllEquipmentStatBonuses() const;
 
+    // Running sum of every equipped item's stat vector
+    const FSHIStatVector& GetEquipmentStatTotal() const { return EquipmentStatTotal; }
+
     // Enhanced shield validation
     UFUNCTION(BlueprintPure, Category = "Shield Logic")
     bool CanEquipShield() const;
@@ -161,7 +202,7 @@ public:
     UFUNCTION(BlueprintPure, Category = "Equipment")
     bool IsValidEquipmentSlot(ESHIEquipmentSlot SlotType, USHIItemData* ItemData) const;
 
-    // Get all equipment slots as array (for UI iteration)
+    // Get all equipment slots as array (for UI iteration - C++ walks EquipmentState.Slots instead)
     UFUNCTION(BlueprintPure, Category = "Equipment")
     TArray<ESHIEquipmentSlot> GetAllEquipmentSlots() const;
 
@@ -172,13 +213,43 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Equipment Events")  
     FOnActiveWeaponChanged OnActiveWeaponChanged;
 
+    UPROPERTY(BlueprintAssignable, Category = "Equipment Events")
+    FOnEquipmentSetChanged OnEquipmentSetChanged;
+
 protected:
     // Network replication
     UFUNCTION()
     void OnRep_EquipmentState();
 
+    // Items as of the last OnRep, so replicated changes can report the old item
+    UPROPERTY(Transient)
+    USHIItemData* LastReplicatedItems[(uint8)ESHIEquipmentSlot::Max];
+
     // Internal helper functions
     void BroadcastEquipmentChange(ESHIEquipmentSlot SlotType, USHIItemData* NewItem, USHIItemData* OldItem);
+    void UpdateEquipmentStatTotal(USHIItemData* NewItem, USHIItemData* OldItem);
+
+    // Slot validation plus shield rule, then the slot writes shared by every equip / unequip path
+    bool CanEquipIntoSlot(ESHIEquipmentSlot SlotType, USHIItemData* ItemData) const;
+    void SetSlotItem(ESHIEquipmentSlot SlotType, USHIItemData* ItemData, int32 Quantity);
+    void ClearSlotItem(ESHIEquipmentSlot SlotType);
+
+    // Per slot events for every bit of ChangedMask, then one OnEquipmentSetChanged
+    void BroadcastEquipmentSet(uint16 ChangedMask, USHIItemData* const* OldItems);
+
+    // Loadout validation - every item fits its slot and a shield comes with a sword
+    bool IsValidLoadout(const FSHIEquipmentLoadout& Loadout) const;
+
+    USHIInventoryComponent* GetOwnerInventory() const;
+
+    // Saved loadouts, only the owning client needs them
+    UPROPERTY(Replicated)
+    TArray<FSHIEquipmentLoadout> Loadouts;
+
+    bool bBroadcastingEquipmentSet = false;
+
+    // Kept on server and clients alike, updated from the same old/new pairs the change events carry
+    FSHIStatVector EquipmentStatTotal;
     void BroadcastActiveWeaponChange();
 
     // Equipment slot validation
@@ -193,6 +264,13 @@ protected:
     bool HasValidSwordEquipped() const;
     USHIItemData* GetEquippedSword() const;
 
+    // Two-handed weapons (IkiElli trait) leave no hand free for a shield
+    bool HasTwoHandedWeaponEquipped() const;
+
+    // Adds the shield's return to an inventory batch when putting NewItem into WeaponSlot leaves no sword
+    bool AddShieldReturnIfNeeded(ESHIEquipmentSlot WeaponSlot, const USHIItemData* NewItem, TArray<FSHIInventoryOp>& Operations) const;
+    void ClearShieldWithoutSword();
+
 public:
     // Debug functions
     UFUNCTION(BlueprintCallable, Category = "Equipment Debug")
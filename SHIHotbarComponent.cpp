@@ -0,0 +1,99 @@
+﻿#include "Components/SHIHotbarComponent.h"
+#include "Engine/Engine.h"
+
+USHIHotbarComponent::USHIHotbarComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(true);
+
+    HotbarSlots.SetNum(NumSlots);
+    LastReplicatedSlots.SetNum(NumSlots);
+}
+
+void USHIHotbarComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // Only the owning player needs its hotbar
+    DOREPLIFETIME_CONDITION(USHIHotbarComponent, HotbarSlots, COND_OwnerOnly);
+}
+
+void USHIHotbarComponent::SetSlotItem(int32 SlotIndex, USHIItemData* Item, int32 Quantity)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return;
+    }
+
+    if (!IsValidSlotIndex(SlotIndex))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SetSlotItem: Invalid hotbar slot index: %d"), SlotIndex);
+        return;
+    }
+
+    WriteSlot(SlotIndex - FirstSlotKey, Item, Quantity);
+
+    UE_LOG(LogTemp, Log, TEXT("Hotbar slot %d set to: %s x%d"),
+        SlotIndex, Item ? *Item->ItemName.ToString() : TEXT("Empty"), Quantity);
+}
+
+USHIItemData* USHIHotbarComponent::ConsumeSlot(int32 SlotIndex)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority() || !IsValidSlotIndex(SlotIndex))
+    {
+        return nullptr;
+    }
+
+    const int32 ArrayIndex = SlotIndex - FirstSlotKey;
+    const FConsumableSlotData& SlotData = HotbarSlots[ArrayIndex];
+    if (SlotData.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Check if item is consumable
+    USHIItemData* Item = SlotData.ItemData;
+    if (Item->ItemType != ESHIItemType::Tuketim)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Item in hotbar slot %d is not consumable"), SlotIndex);
+        return nullptr;
+    }
+
+    WriteSlot(ArrayIndex, Item, SlotData.Quantity - 1);
+    return Item;
+}
+
+FConsumableSlotData USHIHotbarComponent::GetSlot(int32 SlotIndex) const
+{
+    if (!IsValidSlotIndex(SlotIndex))
+    {
+        return FConsumableSlotData();
+    }
+    return HotbarSlots[SlotIndex - FirstSlotKey];
+}
+
+void USHIHotbarComponent::WriteSlot(int32 ArrayIndex, USHIItemData* Item, int32 Quantity)
+{
+    FConsumableSlotData& SlotData = HotbarSlots[ArrayIndex];
+    SlotData.Quantity = Item ? FMath::Max(0, Quantity) : 0;
+    SlotData.ItemData = SlotData.Quantity > 0 ? Item : nullptr;
+
+    OnHotbarSlotChanged.Broadcast(FirstSlotKey + ArrayIndex, SlotData);
+}
+
+void USHIHotbarComponent::OnRep_HotbarSlots()
+{
+    LastReplicatedSlots.SetNum(HotbarSlots.Num());
+    for (int32 i = 0; i < HotbarSlots.Num(); i++)
+    {
+        const FConsumableSlotData& SlotData = HotbarSlots[i];
+        FConsumableSlotData& Known = LastReplicatedSlots[i];
+        if (Known.ItemData == SlotData.ItemData && Known.Quantity == SlotData.Quantity)
+        {
+            continue;
+        }
+
+        Known = SlotData;
+        OnHotbarSlotChanged.Broadcast(FirstSlotKey + i, SlotData);
+    }
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Data/SHIItemData.h"
+#include "Net/UnrealNetwork.h"
+#include "SHIHotbarComponent.generated.h"
+
+USTRUCT(BlueprintType)
+struct FConsumableSlotData
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    USHIItemData* ItemData;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Quantity;
+
+    FConsumableSlotData()
+    {
+        ItemData = nullptr;
+        Quantity = 0;
+    }
+
+    bool IsEmpty() const { return ItemData == nullptr || Quantity <= 0; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHotbarSlotChanged, int32, SlotIndex, const FConsumableSlotData&, SlotData);
+
+// Server owned consumables hotbar (keys 3,4,5,6) - replicated to the owning client, widgets only display it
+UCLASS(ClassGroup=(SHI), meta=(BlueprintSpawnableComponent))
+class STILLHEREISTANBUL_API USHIHotbarComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    USHIHotbarComponent();
+
+    // Hotbar slots are addressed by their key number
+    static constexpr int32 FirstSlotKey = 3;
+    static constexpr int32 NumSlots = 4;
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // Server-side slot changes
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "SHI Consumables")
+    void SetSlotItem(int32 SlotIndex, USHIItemData* Item, int32 Quantity);
+
+    // Takes one consumable out of the slot, returns the item used (nullptr if the slot can't be used)
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "SHI Consumables")
+    USHIItemData* ConsumeSlot(int32 SlotIndex);
+
+    // Query functions
+    UFUNCTION(BlueprintPure, Category = "SHI Consumables")
+    FConsumableSlotData GetSlot(int32 SlotIndex) const;
+
+    UFUNCTION(BlueprintPure, Category = "SHI Consumables")
+    static bool IsValidSlotIndex(int32 SlotIndex) { return SlotIndex >= FirstSlotKey && SlotIndex < FirstSlotKey + NumSlots; }
+
+    const TArray<FConsumableSlotData>& GetAllSlots() const { return HotbarSlots; }
+
+    // Fired on the server and the owning client for every slot that changed
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnHotbarSlotChanged OnHotbarSlotChanged;
+
+protected:
+    UFUNCTION()
+    void OnRep_HotbarSlots();
+
+    void WriteSlot(int32 ArrayIndex, USHIItemData* Item, int32 Quantity);
+
+    // Hotbar data (slots 3,4,5,6)
+    UPROPERTY(ReplicatedUsing = OnRep_HotbarSlots)
+    TArray<FConsumableSlotData> HotbarSlots;
+
+    // Client copy of the last replicated slots, so OnRep only reports the slots that changed
+    TArray<FConsumableSlotData> LastReplicatedSlots;
+};
@@ -1,17 +1,79 @@
 ﻿#include "SHIInventoryComponent.h"
 #include "Engine/Engine.h"
+#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Data/SHIItemRegistry.h"
+#include "Components/SHIStatsComponent.h"
+
+bool FSHIInventorySlot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    USHIItemRegistry::NetSerializeItem(Ar, Map, ItemData);
+
+    uint32 PackedQuantity = FMath::Max(Quantity, 0);
+    Ar.SerializeIntPacked(PackedQuantity);
+
+    // INDEX_NONE goes over the wire as 0
+    uint32 PackedSlotIndex = static_cast<uint32>(SlotIndex + 1);
+    Ar.SerializeIntPacked(PackedSlotIndex);
+
+    if (Ar.IsLoading())
+    {
+        Quantity = static_cast<int32>(PackedQuantity);
+        SlotIndex = static_cast<int32>(PackedSlotIndex) - 1;
+    }
+
+    bOutSuccess = true;
+    return true;
+}
+
+void FSHIInventorySlot::PreReplicatedRemove(const FSHIInventoryList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        // Slot is going away - report it as emptied
+        FSHIInventorySlot RemovedSlot;
+        RemovedSlot.SlotIndex = SlotIndex;
+        InArraySerializer.OwnerComponent->HandleReplicatedSlotChange(RemovedSlot);
+    }
+}
+
+void FSHIInventorySlot::PostReplicatedAdd(const FSHIInventoryList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->HandleReplicatedSlotChange(*this);
+    }
+}
+
+void FSHIInventorySlot::PostReplicatedChange(const FSHIInventoryList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->HandleReplicatedSlotChange(*this);
+    }
+}
+
+void FSHIInventoryList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+    if (OwnerComponent)
+    {
+        OwnerComponent->HandleReplicatedReceive();
+    }
+}
 
 USHIInventoryComponent::USHIInventoryComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
     SetIsReplicatedByDefault(true);
+
+    InventoryList.OwnerComponent = this;
 }
 
 void USHIInventoryComponent::BeginPlay()
 {
     Super::BeginPlay();
     InitializeInventory();
+    RebuildSlotIndex();
     
     UE_LOG(LogTemp, Warning, TEXT("SHI Inventory initialized with %d slots"), InventorySize);
 }
@@ -19,232 +81,1093 @@ void USHIInventoryComponent::BeginPlay()
 void USHIInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-    DOREPLIFETIME(USHIInventoryComponent, InventorySlots);
+    // Inventory contents (and the page being viewed) are private to the owning player
+    DOREPLIFETIME_CONDITION(USHIInventoryComponent, InventoryList, COND_OwnerOnly);
+    DOREPLIFETIME_CONDITION(USHIInventoryComponent, ViewedPage, COND_OwnerOnly);
+    DOREPLIFETIME_CONDITION(USHIInventoryComponent, UsedSlotMask, COND_OwnerOnly);
+    DOREPLIFETIME_CONDITION(USHIInventoryComponent, UsedSlotCount, COND_OwnerOnly);
 }
 
-void USHIInventoryComponent::OnRep_InventorySlots()
+void USHIInventoryComponent::HandleReplicatedSlotChange(const FSHIInventorySlot& Slot)
 {
-    // Broadcast inventory changes to UI
-    for (int32 i = 0; i < InventorySlots.Num(); i++)
+    // Only the slots that actually changed reach this point
+    if (Slot.SlotIndex != INDEX_NONE)
     {
-        OnInventoryChanged.Broadcast(i, InventorySlots[i]);
+        // Paged windows get reindexed once per update in HandleReplicatedReceive
+        if (!bPagedStorage)
+        {
+            UpdateSlotIndex(Slot.SlotIndex, Slot.ItemData, Slot.Quantity);
+        }
+        QueueSlotChange(Slot.SlotIndex);
+    }
+}
+
+void USHIInventoryComponent::HandleReplicatedReceive()
+{
+    // A page window reuses its items for other slots, rebuild instead of diffing stale absolute indices
+    if (bPagedStorage)
+    {
+        RebuildSlotIndex();
     }
 }
 
 void USHIInventoryComponent::InitializeInventory()
 {
-    if (InventorySlots.Num() != InventorySize)
+    // Slots are created by the server only, clients receive them through the fast array
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return;
+    }
+
+    if (bPagedStorage)
+    {
+        // Full storage stays on the server, the replicated list only carries the viewed page
+        PageSize = FMath::Max(PageSize, 1);
+        PagedStorage.SetNum(InventorySize);
+        for (int32 i = 0; i < InventorySize; i++)
+        {
+            PagedStorage[i] = FSHIInventorySlot();
+            PagedStorage[i].SlotIndex = i;
+        }
+
+        InventoryList.Items.SetNum(FMath::Min(PageSize, InventorySize));
+        ViewedPage = FMath::Clamp(ViewedPage, 0, GetPageCount() - 1);
+        RefreshPageWindow();
+        return;
+    }
+
+    if (InventoryList.Items.Num() != InventorySize)
     {
-        InventorySlots.SetNum(InventorySize);
+        InventoryList.Items.SetNum(InventorySize);
         for (int32 i = 0; i < InventorySize; i++)
         {
-            InventorySlots[i] = FSHIInventorySlot();
+            InventoryList.Items[i] = FSHIInventorySlot();
+            InventoryList.Items[i].SlotIndex = i;
+            InventoryList.MarkItemDirty(InventoryList.Items[i]);
         }
     }
 }
 
-void USHIInventoryComponent::Server_AddItem_Implementation(USHIItemData* ItemData, int32 Quantity)
+void USHIInventoryComponent::Server_SetViewedPage_Implementation(int32 Page)
 {
-    if (!ItemData || Quantity <= 0)
+    if (!bPagedStorage)
     {
         return;
     }
-    
-    int32 RemainingQuantity = Quantity;
-    
-    // First, try to stack with existing items
-    if (ItemData->IsStackable())
+
+    const int32 NewPage = FMath::Clamp(Page, 0, GetPageCount() - 1);
+    if (NewPage == ViewedPage)
     {
-        for (int32 i = 0; i < InventorySlots.Num(); i++)
+        return;
+    }
+
+    ViewedPage = NewPage;
+    RefreshPageWindow();
+    OnInventoryPageChanged.Broadcast(ViewedPage);
+
+    UE_LOG(LogTemp, Log, TEXT("Inventory page %d/%d streamed to owner"), ViewedPage + 1, GetPageCount());
+}
+
+void USHIInventoryComponent::OnRep_ViewedPage()
+{
+    OnInventoryPageChanged.Broadcast(ViewedPage);
+}
+
+void USHIInventoryComponent::OnRep_UsedSlotMask()
+{
+    ApplyUsedSlotMask();
+}
+
+void USHIInventoryComponent::ApplyUsedSlotMask()
+{
+    if (!bPagedStorage || GetOwnerRole() == ROLE_Authority)
+    {
+        return;
+    }
+
+    EnsureSlotIndexSize();
+    for (int32 i = 0; i < FreeSlotBits.Num(); i++)
+    {
+        const int32 Word = i / 32;
+        const bool bUsed = UsedSlotMask.IsValidIndex(Word) && (UsedSlotMask[Word] & (1u << (i % 32))) != 0;
+        FreeSlotBits[i] = !bUsed;
+    }
+    NumFreeSlots = FMath::Max(0, IndexedSlots.Num() - UsedSlotCount);
+}
+
+int32 USHIInventoryComponent::GetPageCount() const
+{
+    if (!bPagedStorage)
+    {
+        return 1;
+    }
+    const int32 SlotsPerPage = FMath::Max(PageSize, 1);
+    return FMath::Max(1, FMath::DivideAndRoundUp(InventorySize, SlotsPerPage));
+}
+
+int32 USHIInventoryComponent::GetSlotsPerPage() const
+{
+    return bPagedStorage ? FMath::Min(FMath::Max(PageSize, 1), InventorySize) : InventorySize;
+}
+
+void USHIInventoryComponent::RefreshPageWindow()
+{
+    // Copy the viewed page into the window, only items that now show something else get dirtied
+    const int32 FirstSlot = ViewedPage * PageSize;
+    for (int32 i = 0; i < InventoryList.Items.Num(); i++)
+    {
+        FSHIInventorySlot& WindowSlot = InventoryList.Items[i];
+        const int32 SlotIndex = FirstSlot + i;
+
+        if (PagedStorage.IsValidIndex(SlotIndex))
         {
-            if (InventorySlots[i].CanStackWith(ItemData))
+            const FSHIInventorySlot& Stored = PagedStorage[SlotIndex];
+            if (WindowSlot.SlotIndex == SlotIndex && WindowSlot.ItemData == Stored.ItemData && WindowSlot.Quantity == Stored.Quantity)
             {
-                int32 CanAdd = ItemData->MaxStackSize - InventorySlots[i].Quantity;
-                int32 AddAmount = FMath::Min(CanAdd, RemainingQuantity);
-                
-                if (AddAmount > 0)
-                {
-                    InventorySlots[i].Quantity += AddAmount;
-                    RemainingQuantity -= AddAmount;
-                    BroadcastSlotChange(i);
-                    
-                    if (RemainingQuantity <= 0)
-                        break;
-                }
+                continue;
+            }
+            WindowSlot.SetContents(Stored.ItemData, Stored.Quantity);
+            WindowSlot.SlotIndex = SlotIndex;
+        }
+        else
+        {
+            // Past the end of the last page
+            if (WindowSlot.SlotIndex == INDEX_NONE)
+            {
+                continue;
             }
+            WindowSlot.Clear();
+            WindowSlot.SlotIndex = INDEX_NONE;
         }
+
+        InventoryList.MarkItemDirty(WindowSlot);
     }
+}
+
+TArray<FSHIInventorySlot>& USHIInventoryComponent::GetStorageSlots()
+{
+    // Paged containers keep the full storage on the server, InventoryList only mirrors the viewed page
+    return (bPagedStorage && GetOwnerRole() == ROLE_Authority) ? PagedStorage : InventoryList.Items;
+}
+
+const TArray<FSHIInventorySlot>& USHIInventoryComponent::GetStorageSlots() const
+{
+    return (bPagedStorage && GetOwnerRole() == ROLE_Authority) ? PagedStorage : InventoryList.Items;
+}
+
+void USHIInventoryComponent::Server_AddItem_Implementation(USHIItemData* ItemData, int32 Quantity)
+{
+    if (!ItemData || Quantity <= 0)
+    {
+        return;
+    }
+    
+    int32 RemainingQuantity = Quantity - TryAddItem(ItemData, Quantity);
     
-    // Then add to empty slots
-    while (RemainingQuantity > 0)
+    if (RemainingQuantity > 0)
     {
-        int32 EmptySlot = FindFirstEmptySlot();
-        if (EmptySlot == -1)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("Inventory full! Could not add %d of %s"), 
-                   RemainingQuantity, *ItemData->ItemName.ToString());
-            break;
-        }
-        
-        int32 AddAmount = ItemData->IsStackable() ? 
-            FMath::Min(RemainingQuantity, ItemData->MaxStackSize) : 1;
-            
-        InventorySlots[EmptySlot].ItemData = ItemData;
-        InventorySlots[EmptySlot].Quantity = AddAmount;
-        RemainingQuantity -= AddAmount;
-        
-        BroadcastSlotChange(EmptySlot);
-        OnItemAdded.Broadcast(ItemData, AddAmount, EmptySlot);
-        
-        UE_LOG(LogTemp, Log, TEXT("Added %d of %s to slot %d"), 
-               AddAmount, *ItemData->ItemName.ToString(), EmptySlot);
+        UE_LOG(LogTemp, Warning, TEXT("Inventory full! Could not add %d of %s"), 
+               RemainingQuantity, *ItemData->ItemName.ToString());
     }
 }
 
 void USHIInventoryComponent::Server_RemoveItem_Implementation(int32 SlotIndex, int32 Quantity)
 {
-    if (SlotIndex < 0 || SlotIndex >= InventorySlots.Num())
+    BeginTransaction();
+    int32 RemoveAmount = RemoveFromSlotInternal(SlotIndex, Quantity);
+    CommitTransaction();
+    
+    if (RemoveAmount > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Removed %d items from slot %d"), RemoveAmount, SlotIndex);
+    }
+}
+
+void USHIInventoryComponent::Server_MoveItem_Implementation(int32 FromSlot, int32 ToSlot)
+{
+    BeginTransaction();
+    bool bMoved = MoveItemInternal(FromSlot, ToSlot, 0);
+    CommitTransaction();
+    
+    if (bMoved)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Moved item from slot %d to slot %d"), FromSlot, ToSlot);
+    }
+}
+
+void USHIInventoryComponent::Server_MoveItemQuantity_Implementation(int32 FromSlot, int32 ToSlot, int32 Quantity)
+{
+    if (Quantity <= 0)
         return;
-        
-    if (InventorySlots[SlotIndex].IsEmpty())
+    
+    BeginTransaction();
+    bool bMoved = MoveItemInternal(FromSlot, ToSlot, Quantity);
+    CommitTransaction();
+    
+    if (bMoved)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Moved %d items from slot %d to slot %d"), Quantity, FromSlot, ToSlot);
+    }
+}
+
+void USHIInventoryComponent::Server_SplitStack_Implementation(int32 SlotIndex, int32 Quantity, int32 TargetSlot)
+{
+    const FSHIInventorySlot* Slot = FindSlot(SlotIndex);
+    if (!Slot || Slot->IsEmpty() || Quantity <= 0 || Quantity >= Slot->Quantity)
         return;
     
-    int32 RemoveAmount = FMath::Min(Quantity, InventorySlots[SlotIndex].Quantity);
-    InventorySlots[SlotIndex].Quantity -= RemoveAmount;
+    // No target picked - split into the first free slot
+    if (TargetSlot == INDEX_NONE)
+    {
+        TargetSlot = FindFirstEmptySlot();
+    }
     
-    if (InventorySlots[SlotIndex].Quantity <= 0)
+    const FSHIInventorySlot* Target = FindSlot(TargetSlot);
+    if (!Target || !Target->IsEmpty())
     {
-        InventorySlots[SlotIndex].ItemData = nullptr;
-        InventorySlots[SlotIndex].Quantity = 0;
+        UE_LOG(LogTemp, Warning, TEXT("Cannot split slot %d, no empty target slot"), SlotIndex);
+        return;
     }
     
-    BroadcastSlotChange(SlotIndex);
+    BeginTransaction();
+    bool bSplit = MoveItemInternal(SlotIndex, TargetSlot, Quantity);
+    CommitTransaction();
     
-    UE_LOG(LogTemp, Log, TEXT("Removed %d items from slot %d"), RemoveAmount, SlotIndex);
+    if (bSplit)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Split %d items from slot %d into slot %d"), Quantity, SlotIndex, TargetSlot);
+    }
 }
 
-void USHIInventoryComponent::Server_MoveItem_Implementation(int32 FromSlot, int32 ToSlot)
+void USHIInventoryComponent::Server_MergeStacks_Implementation(int32 FromSlot, int32 ToSlot)
 {
-    if (FromSlot < 0 || FromSlot >= InventorySlots.Num() || 
-        ToSlot < 0 || ToSlot >= InventorySlots.Num() || 
-        FromSlot == ToSlot)
+    const FSHIInventorySlot* From = FindSlot(FromSlot);
+    const FSHIInventorySlot* To = FindSlot(ToSlot);
+    if (!From || !To || From->IsEmpty() || !To->CanStackWith(From->ItemData))
         return;
     
-    // Swap slots
-    FSHIInventorySlot TempSlot = InventorySlots[FromSlot];
-    InventorySlots[FromSlot] = InventorySlots[ToSlot];
-    InventorySlots[ToSlot] = TempSlot;
-    
-    BroadcastSlotChange(FromSlot);
-    BroadcastSlotChange(ToSlot);
+    BeginTransaction();
+    bool bMerged = MoveItemInternal(FromSlot, ToSlot, 0);
+    CommitTransaction();
     
-    UE_LOG(LogTemp, Log, TEXT("Moved item from slot %d to slot %d"), FromSlot, ToSlot);
+    if (bMerged)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Merged stack from slot %d into slot %d"), FromSlot, ToSlot);
+    }
 }
 
 void USHIInventoryComponent::Server_UseItem_Implementation(int32 SlotIndex)
 {
-    if (SlotIndex < 0 || SlotIndex >= InventorySlots.Num())
+    if (SlotIndex < 0 || SlotIndex >= GetStorageSlots().Num())
         return;
         
-    if (InventorySlots[SlotIndex].IsEmpty())
+    if (GetStorageSlots()[SlotIndex].IsEmpty())
         return;
     
-    USHIItemData* ItemData = InventorySlots[SlotIndex].ItemData;
+    USHIItemData* ItemData = GetStorageSlots()[SlotIndex].ItemData;
     
-    // For now, just remove consumable items when used
+    // Remove the consumable and apply its effect in the same server step
     if (ItemData->ItemType == ESHIItemType::Tuketim)
     {
         Server_RemoveItem(SlotIndex, 1);
+        if (USHIStatsComponent* StatsComponent = GetOwner()->FindComponentByClass<USHIStatsComponent>())
+        {
+            StatsComponent->ApplyConsumable(ItemData);
+        }
         UE_LOG(LogTemp, Log, TEXT("Used consumable: %s"), *ItemData->ItemName.ToString());
     }
 }
 
-bool USHIInventoryComponent::CanAddItem(USHIItemData* ItemData, int32 Quantity) const
+void USHIInventoryComponent::Server_SortInventory_Implementation(ESHIInventorySortMode SortMode)
 {
-    if (!ItemData || Quantity <= 0)
+    // Merged totals come straight from the stack index, no slot scan needed
+    TArray<TPair<USHIItemData*, int32>> SortedItems;
+    SortedItems.Reserve(ItemStackIndex.Num());
+    for (const TPair<USHIItemData*, FSHIItemStackIndex>& Entry : ItemStackIndex)
+    {
+        SortedItems.Emplace(Entry.Key, Entry.Value.TotalQuantity);
+    }
+    
+    SortedItems.Sort([SortMode](const TPair<USHIItemData*, int32>& PairA, const TPair<USHIItemData*, int32>& PairB)
+    {
+        const USHIItemData& A = *PairA.Key;
+        const USHIItemData& B = *PairB.Key;
+        
+        switch (SortMode)
+        {
+            case ESHIInventorySortMode::ByType:
+                if (A.ItemType != B.ItemType) return A.ItemType < B.ItemType;
+                if (A.Rarity != B.Rarity) return A.Rarity > B.Rarity;
+                break;
+            case ESHIInventorySortMode::ByRarity:
+                if (A.Rarity != B.Rarity) return A.Rarity > B.Rarity;
+                if (A.ItemType != B.ItemType) return A.ItemType < B.ItemType;
+                break;
+            case ESHIInventorySortMode::ByValue:
+                if (A.ItemValue != B.ItemValue) return A.ItemValue > B.ItemValue;
+                if (A.ItemType != B.ItemType) return A.ItemType < B.ItemType;
+                break;
+        }
+        
+        // Stable tie-break so the same bag always sorts the same way
+        return A.GetFName().LexicalLess(B.GetFName());
+    });
+    
+    // Write the target layout directly - slots that already hold their target are left alone
+    const TArray<FSHIInventorySlot>& Slots = GetStorageSlots();
+    int32 TargetSlot = 0;
+    int32 ChangedSlots = 0;
+    bool bOverflow = false;
+    
+    BeginTransaction();
+    
+    for (const TPair<USHIItemData*, int32>& Item : SortedItems)
+    {
+        USHIItemData* ItemData = Item.Key;
+        const int32 StackSize = FMath::Max(ItemData->MaxStackSize, 1);
+        int32 RemainingQuantity = Item.Value;
+        
+        while (RemainingQuantity > 0 && TargetSlot < Slots.Num())
+        {
+            const int32 Amount = FMath::Min(RemainingQuantity, StackSize);
+            if (Slots[TargetSlot].ItemData != ItemData || Slots[TargetSlot].Quantity != Amount)
+            {
+                SetSlotContents(TargetSlot, ItemData, Amount);
+                ChangedSlots++;
+            }
+            RemainingQuantity -= Amount;
+            TargetSlot++;
+        }
+        
+        bOverflow |= RemainingQuantity > 0;
+    }
+    
+    // Everything after the sorted block ends up empty
+    for (; TargetSlot < Slots.Num(); TargetSlot++)
+    {
+        if (!Slots[TargetSlot].IsEmpty())
+        {
+            SetSlotContents(TargetSlot, nullptr, 0);
+            ChangedSlots++;
+        }
+    }
+    
+    // Only possible with oversized legacy stacks - never drop items
+    if (bOverflow)
+    {
+        RollbackTransaction();
+        UE_LOG(LogTemp, Warning, TEXT("Inventory sort aborted, sorted layout does not fit"));
+        return;
+    }
+    
+    CommitTransaction();
+    
+    UE_LOG(LogTemp, Log, TEXT("Sorted inventory: %d item types, %d slots rewritten"), SortedItems.Num(), ChangedSlots);
+}
+
+void USHIInventoryComponent::Server_ApplyBatch_Implementation(const TArray<FSHIInventoryOp>& Operations)
+{
+    // A client may only rearrange what it already has - an Add or Remove from here would create or destroy items
+    for (const FSHIInventoryOp& Operation : Operations)
+    {
+        if (Operation.OpType != ESHIInventoryOpType::Move)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Rejected client inventory batch - only Move operations are allowed"));
+            return;
+        }
+    }
+    
+    ApplyBatch(Operations);
+}
+
+bool USHIInventoryComponent::ApplyBatch(const TArray<FSHIInventoryOp>& Operations)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
         return false;
+    }
     
+    BeginTransaction();
+    
+    // Operations run in order, so removals free space for the adds that follow them
+    for (int32 i = 0; i < Operations.Num(); i++)
+    {
+        if (!ApplyOperation(Operations[i]))
+        {
+            RollbackTransaction();
+            UE_LOG(LogTemp, Warning, TEXT("Inventory batch failed at operation %d of %d, rolled back"), 
+                   i, Operations.Num());
+            return false;
+        }
+    }
+    
+    CommitTransaction();
+    
+    UE_LOG(LogTemp, Log, TEXT("Applied inventory batch with %d operations"), Operations.Num());
+    return true;
+}
+
+bool USHIInventoryComponent::ApplyOperation(const FSHIInventoryOp& Operation)
+{
+    switch (Operation.OpType)
+    {
+        case ESHIInventoryOpType::Add:
+            if (!Operation.ItemData || Operation.Quantity <= 0)
+                return false;
+            if (Operation.SlotIndex != INDEX_NONE)
+                return AddToSlotInternal(Operation.SlotIndex, Operation.ItemData, Operation.Quantity);
+            // Capacity check - the whole quantity has to fit
+            return AddItemInternal(Operation.ItemData, Operation.Quantity) == 0;
+            
+        case ESHIInventoryOpType::Remove:
+            if (Operation.Quantity <= 0)
+                return false;
+            if (Operation.SlotIndex != INDEX_NONE)
+            {
+                const FSHIInventorySlot* Slot = FindSlot(Operation.SlotIndex);
+                if (!Slot || Slot->IsEmpty() || Slot->Quantity < Operation.Quantity)
+                    return false;
+                if (Operation.ItemData && Slot->ItemData != Operation.ItemData)
+                    return false;
+                return RemoveFromSlotInternal(Operation.SlotIndex, Operation.Quantity) == Operation.Quantity;
+            }
+            return RemoveItemInternal(Operation.ItemData, Operation.Quantity);
+            
+        case ESHIInventoryOpType::Move:
+            return MoveItemInternal(Operation.SlotIndex, Operation.TargetSlotIndex, Operation.Quantity);
+            
+        default:
+            return false;
+    }
+}
+
+int32 USHIInventoryComponent::AddItemInternal(USHIItemData* ItemData, int32 Quantity)
+{
+    if (!ItemData || Quantity <= 0)
+    {
+        return Quantity;
+    }
+    
+    FSHIAddPlan Plan = PlanAddItem(ItemData, Quantity);
+    ApplyAddPlan(Plan);
+    return Quantity - Plan.FitQuantity;
+}
+
+FSHIAddPlan USHIInventoryComponent::PlanAddItem(USHIItemData* ItemData, int32 Quantity) const
+{
+    FSHIAddPlan Plan;
+    Plan.ItemData = ItemData;
+    Plan.RequestedQuantity = FMath::Max(Quantity, 0);
+    
+    if (ItemData && Quantity > 0)
+    {
+        Plan.FitQuantity = PlanAddItemInternal(ItemData, Quantity, &Plan.Entries);
+    }
+    return Plan;
+}
+
+int32 USHIInventoryComponent::PlanAddItemInternal(USHIItemData* ItemData, int32 Quantity, TArray<FSHIAddPlanEntry>* OutEntries) const
+{
     int32 RemainingQuantity = Quantity;
     
-    // Check existing stacks
+    // First, top up the existing stacks of this item (index, no full scan)
     if (ItemData->IsStackable())
     {
-        for (const auto& Slot : InventorySlots)
+        if (const FSHIItemStackIndex* Entry = ItemStackIndex.Find(ItemData))
         {
-            if (Slot.CanStackWith(ItemData))
+            if (!OutEntries)
+            {
+                // Count only - free room across the stacks is known from the index totals
+                const int32 StackCapacity = Entry->SlotIndices.Num() * ItemData->MaxStackSize - Entry->TotalQuantity;
+                RemainingQuantity -= FMath::Clamp(StackCapacity, 0, RemainingQuantity);
+            }
+            else
             {
-                int32 CanAdd = ItemData->MaxStackSize - Slot.Quantity;
-                RemainingQuantity -= CanAdd;
-                if (RemainingQuantity <= 0)
-                    return true;
+                TArray<int32, TInlineAllocator<4>> StackSlots = Entry->SlotIndices;
+                StackSlots.Sort();
+                
+                for (int32 SlotIndex : StackSlots)
+                {
+                    if (RemainingQuantity <= 0)
+                        break;
+                    
+                    // Stacks are indexed by absolute slot, a paged client window is not
+                    const FSHIInventorySlot* StackSlot = FindSlot(SlotIndex);
+                    if (!StackSlot)
+                        continue;
+                    
+                    int32 CanAdd = ItemData->MaxStackSize - StackSlot->Quantity;
+                    int32 AddAmount = FMath::Min(CanAdd, RemainingQuantity);
+                    if (AddAmount > 0)
+                    {
+                        FSHIAddPlanEntry& PlanEntry = OutEntries->AddDefaulted_GetRef();
+                        PlanEntry.SlotIndex = SlotIndex;
+                        PlanEntry.Quantity = AddAmount;
+                        RemainingQuantity -= AddAmount;
+                    }
+                }
             }
         }
     }
     
-    // Check empty slots
-    int32 EmptySlots = 0;
-    for (const auto& Slot : InventorySlots)
+    // Then empty slots
+    const int32 PerSlot = ItemData->IsStackable() ? ItemData->MaxStackSize : 1;
+    if (!OutEntries)
     {
-        if (Slot.IsEmpty())
-            EmptySlots++;
+        const int64 EmptyCapacity = int64(NumFreeSlots) * PerSlot;
+        RemainingQuantity -= int32(FMath::Min<int64>(EmptyCapacity, RemainingQuantity));
+    }
+    else
+    {
+        // The search continues from the last free slot instead of restarting
+        int32 EmptySlot = -1;
+        while (RemainingQuantity > 0)
+        {
+            EmptySlot = FreeSlotBits.FindFrom(true, EmptySlot + 1);
+            if (EmptySlot == INDEX_NONE || EmptySlot >= InventorySize)
+            {
+                break;
+            }
+            
+            FSHIAddPlanEntry& PlanEntry = OutEntries->AddDefaulted_GetRef();
+            PlanEntry.SlotIndex = EmptySlot;
+            PlanEntry.Quantity = FMath::Min(RemainingQuantity, PerSlot);
+            RemainingQuantity -= PlanEntry.Quantity;
+        }
     }
     
-    int32 SlotsNeeded = ItemData->IsStackable() ? 
-        FMath::CeilToInt(float(RemainingQuantity) / ItemData->MaxStackSize) : RemainingQuantity;
-    
-    return EmptySlots >= SlotsNeeded;
+    return Quantity - RemainingQuantity;
 }
 
-int32 USHIInventoryComponent::GetItemCount(USHIItemData* ItemData) const
+void USHIInventoryComponent::ApplyAddPlan(const FSHIAddPlan& Plan)
 {
-    int32 TotalCount = 0;
-    for (const auto& Slot : InventorySlots)
+    const TArray<FSHIInventorySlot>& Slots = GetStorageSlots();
+    
+    for (const FSHIAddPlanEntry& Entry : Plan.Entries)
     {
-        if (Slot.ItemData == ItemData)
+        if (!Slots.IsValidIndex(Entry.SlotIndex) || Entry.Quantity <= 0)
+            continue;
+        
+        // Plans are applied right after they are made, a different item here means the slot changed in between
+        const FSHIInventorySlot& Slot = Slots[Entry.SlotIndex];
+        const bool bNewStack = Slot.IsEmpty();
+        if (!bNewStack && Slot.ItemData != Plan.ItemData)
+            continue;
+        
+        SetSlotContents(Entry.SlotIndex, Plan.ItemData, (bNewStack ? 0 : Slot.Quantity) + Entry.Quantity);
+        
+        if (bNewStack)
         {
-            TotalCount += Slot.Quantity;
+            FSHIPendingItemAdded& Added = PendingItemAdded.AddDefaulted_GetRef();
+            Added.ItemData = Plan.ItemData;
+            Added.Quantity = Entry.Quantity;
+            Added.SlotIndex = Entry.SlotIndex;
+            
+            UE_LOG(LogTemp, Verbose, TEXT("Added %d of %s to slot %d"), 
+                   Entry.Quantity, *Plan.ItemData->ItemName.ToString(), Entry.SlotIndex);
         }
     }
-    return TotalCount;
+}
+
+bool USHIInventoryComponent::AddToSlotInternal(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity)
+{
+    const FSHIInventorySlot* Slot = FindSlot(SlotIndex);
+    if (!Slot || !ItemData || Quantity <= 0)
+        return false;
+    
+    // An empty slot takes one stack, an occupied one only more of the same item up to MaxStackSize
+    const int32 PerSlot = ItemData->IsStackable() ? ItemData->MaxStackSize : 1;
+    const int32 Existing = Slot->IsEmpty() ? 0 : Slot->Quantity;
+    if ((!Slot->IsEmpty() && !Slot->CanStackWith(ItemData)) || Existing + Quantity > PerSlot)
+        return false;
+    
+    FSHIAddPlan Plan;
+    Plan.ItemData = ItemData;
+    Plan.RequestedQuantity = Quantity;
+    Plan.FitQuantity = Quantity;
+    FSHIAddPlanEntry& Entry = Plan.Entries.AddDefaulted_GetRef();
+    Entry.SlotIndex = SlotIndex;
+    Entry.Quantity = Quantity;
+    ApplyAddPlan(Plan);
+    return true;
+}
+
+int32 USHIInventoryComponent::TryAddItem(USHIItemData* ItemData, int32 Quantity)
+{
+    if (!ItemData || Quantity <= 0 || !GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return 0;
+    }
+    
+    BeginTransaction();
+    int32 RemainingQuantity = AddItemInternal(ItemData, Quantity);
+    CommitTransaction();
+    
+    return Quantity - RemainingQuantity;
+}
+
+int32 USHIInventoryComponent::RemoveFromSlotInternal(int32 SlotIndex, int32 Quantity)
+{
+    if (SlotIndex < 0 || SlotIndex >= GetStorageSlots().Num() || Quantity <= 0)
+        return 0;
+        
+    const FSHIInventorySlot& Slot = GetStorageSlots()[SlotIndex];
+    if (Slot.IsEmpty())
+        return 0;
+    
+    int32 RemoveAmount = FMath::Min(Quantity, Slot.Quantity);
+    
+    // SetContents clears the slot once the quantity reaches zero
+    SetSlotContents(SlotIndex, Slot.ItemData, Slot.Quantity - RemoveAmount);
+    return RemoveAmount;
+}
+
+bool USHIInventoryComponent::RemoveItemInternal(USHIItemData* ItemData, int32 Quantity)
+{
+    if (!ItemData || Quantity <= 0 || GetItemCount(ItemData) < Quantity)
+    {
+        return false;
+    }
+    
+    // Take from the last stacks first so the front of the bag stays put
+    TArray<int32, TInlineAllocator<4>> StackSlots = ItemStackIndex.FindChecked(ItemData).SlotIndices;
+    StackSlots.Sort(TGreater<int32>());
+    
+    int32 RemainingQuantity = Quantity;
+    for (int32 SlotIndex : StackSlots)
+    {
+        RemainingQuantity -= RemoveFromSlotInternal(SlotIndex, RemainingQuantity);
+        if (RemainingQuantity <= 0)
+            break;
+    }
+    
+    return RemainingQuantity <= 0;
+}
+
+bool USHIInventoryComponent::MoveItemInternal(int32 FromSlot, int32 ToSlot, int32 Quantity)
+{
+    if (FromSlot < 0 || FromSlot >= GetStorageSlots().Num() || 
+        ToSlot < 0 || ToSlot >= GetStorageSlots().Num() || 
+        FromSlot == ToSlot)
+        return false;
+    
+    const FSHIInventorySlot& From = GetStorageSlots()[FromSlot];
+    const FSHIInventorySlot& To = GetStorageSlots()[ToSlot];
+    
+    // Quantity <= 0 moves as much of the stack as possible, an explicit quantity has to fit exactly
+    const bool bExactQuantity = Quantity > 0;
+    if (bExactQuantity && (From.IsEmpty() || Quantity > From.Quantity))
+        return false;
+    
+    USHIItemData* ItemData = From.ItemData;
+    const int32 MoveAmount = bExactQuantity ? Quantity : From.Quantity;
+    
+    // Merge onto a stack of the same item, never past MaxStackSize.
+    // A whole-stack move onto a full stack falls through to the swap below.
+    const int32 Space = (!From.IsEmpty() && To.CanStackWith(ItemData)) ? ItemData->MaxStackSize - To.Quantity : 0;
+    if (!From.IsEmpty() && To.CanStackWith(ItemData) && (bExactQuantity || Space > 0))
+    {
+        const int32 Merged = bExactQuantity ? MoveAmount : FMath::Min(MoveAmount, Space);
+        if (Merged <= 0 || Merged > Space)
+            return false;
+        
+        SetSlotContents(ToSlot, ItemData, To.Quantity + Merged);
+        SetSlotContents(FromSlot, ItemData, From.Quantity - Merged);
+        return true;
+    }
+    
+    // Split part of the stack into an empty slot
+    if (MoveAmount < From.Quantity)
+    {
+        if (!To.IsEmpty())
+            return false;
+        
+        SetSlotContents(ToSlot, ItemData, MoveAmount);
+        SetSlotContents(FromSlot, ItemData, From.Quantity - MoveAmount);
+        return true;
+    }
+    
+    // Whole stack - swap slot contents (replication IDs must stay with their slots)
+    USHIItemData* TempItem = From.ItemData;
+    int32 TempQuantity = From.Quantity;
+    SetSlotContents(FromSlot, To.ItemData, To.Quantity);
+    SetSlotContents(ToSlot, TempItem, TempQuantity);
+    return true;
+}
+
+bool USHIInventoryComponent::CanAddItem(USHIItemData* ItemData, int32 Quantity) const
+{
+    if (!ItemData || Quantity <= 0)
+        return false;
+    
+    return PlanAddItemInternal(ItemData, Quantity, nullptr) >= Quantity;
+}
+
+int32 USHIInventoryComponent::GetItemCount(USHIItemData* ItemData) const
+{
+    const FSHIItemStackIndex* Entry = ItemStackIndex.Find(ItemData);
+    return Entry ? Entry->TotalQuantity : 0;
 }
 
 FSHIInventorySlot USHIInventoryComponent::GetSlot(int32 SlotIndex) const
 {
-    if (SlotIndex >= 0 && SlotIndex < InventorySlots.Num())
+    if (const FSHIInventorySlot* Slot = FindSlot(SlotIndex))
     {
-        return InventorySlots[SlotIndex];
+        return *Slot;
     }
     return FSHIInventorySlot();
 }
 
+const FSHIInventorySlot* USHIInventoryComponent::FindSlot(int32 SlotIndex) const
+{
+    if (SlotIndex < 0)
+    {
+        return nullptr;
+    }
+
+    const TArray<FSHIInventorySlot>& Slots = GetStorageSlots();
+
+    // Slots keep their server order, a paged client window starts at the first slot of the viewed page
+    const bool bPageWindow = bPagedStorage && GetOwnerRole() != ROLE_Authority;
+    const int32 LocalIndex = bPageWindow ? SlotIndex - ViewedPage * PageSize : SlotIndex;
+    if (Slots.IsValidIndex(LocalIndex) && Slots[LocalIndex].SlotIndex == SlotIndex)
+    {
+        return &Slots[LocalIndex];
+    }
+
+    // Fall back to a search if a client received them out of order
+    return Slots.FindByPredicate([SlotIndex](const FSHIInventorySlot& Other)
+    {
+        return Other.SlotIndex == SlotIndex;
+    });
+}
+
 int32 USHIInventoryComponent::FindFirstEmptySlot() const
 {
-    for (int32 i = 0; i < InventorySlots.Num(); i++)
+    int32 EmptySlot = FreeSlotBits.Find(true);
+    return (EmptySlot != INDEX_NONE && EmptySlot < InventorySize) ? EmptySlot : -1;
+}
+
+int32 USHIInventoryComponent::FindItemSlot(USHIItemData* ItemData) const
+{
+    if (!ItemData)
+    {
+        return FindFirstEmptySlot();
+    }
+
+    // Lowest slot holding the item, same result as the old front-to-back scan
+    int32 Result = -1;
+    if (const FSHIItemStackIndex* Entry = ItemStackIndex.Find(ItemData))
     {
-        if (InventorySlots[i].IsEmpty())
+        for (int32 SlotIndex : Entry->SlotIndices)
         {
-            return i;
+            if (Result == -1 || SlotIndex < Result)
+            {
+                Result = SlotIndex;
+            }
         }
     }
-    return -1;
+    return Result;
 }
 
-int32 USHIInventoryComponent::FindItemSlot(USHIItemData* ItemData) const
+void USHIInventoryComponent::MarkSlotDirty(int32 SlotIndex)
 {
-    for (int32 i = 0; i < InventorySlots.Num(); i++)
+    if (bPagedStorage)
     {
-        if (InventorySlots[i].ItemData == ItemData)
+        // Only slots on the viewed page exist in the replicated window
+        const int32 LocalIndex = SlotIndex - ViewedPage * PageSize;
+        if (PagedStorage.IsValidIndex(SlotIndex) && InventoryList.Items.IsValidIndex(LocalIndex))
         {
-            return i;
+            const FSHIInventorySlot& Stored = PagedStorage[SlotIndex];
+            FSHIInventorySlot& WindowSlot = InventoryList.Items[LocalIndex];
+            WindowSlot.SetContents(Stored.ItemData, Stored.Quantity);
+            WindowSlot.SlotIndex = SlotIndex;
+            InventoryList.MarkItemDirty(WindowSlot);
         }
     }
-    return -1;
+    else if (InventoryList.Items.IsValidIndex(SlotIndex))
+    {
+        InventoryList.MarkItemDirty(InventoryList.Items[SlotIndex]);
+    }
+
+    QueueSlotChange(SlotIndex);
+}
+
+void USHIInventoryComponent::QueueSlotChange(int32 SlotIndex)
+{
+    // Per slot event fires right away - the ownership index has to agree with equipment and hotbar,
+    // whose events are immediate too. Journalled writes only get here once their transaction commits.
+    BroadcastSlotChange(SlotIndex);
+    
+    PendingChangedSlots.Add(SlotIndex);
+    
+    if (bSlotFlushScheduled)
+    {
+        return;
+    }
+    
+    // The aggregate for everything that changed this frame goes out in one flush on the next tick
+    if (UWorld* World = GetWorld())
+    {
+        bSlotFlushScheduled = true;
+        World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &USHIInventoryComponent::FlushSlotChanges));
+    }
+    else
+    {
+        FlushSlotChanges();
+    }
+}
+
+void USHIInventoryComponent::FlushSlotChanges()
+{
+    bSlotFlushScheduled = false;
+    if (PendingChangedSlots.Num() == 0)
+    {
+        return;
+    }
+    
+    TArray<int32> ChangedSlots = PendingChangedSlots.Array();
+    PendingChangedSlots.Reset();
+    ChangedSlots.Sort();
+    
+    OnInventorySlotsChanged.Broadcast(ChangedSlots);
 }
 
 void USHIInventoryComponent::BroadcastSlotChange(int32 SlotIndex)
 {
-    if (SlotIndex >= 0 && SlotIndex < InventorySlots.Num())
+    if (const FSHIInventorySlot* Slot = FindSlot(SlotIndex))
+    {
+        OnInventoryChanged.Broadcast(SlotIndex, *Slot);
+    }
+    else
+    {
+        // Slot left the replicated window - report it as emptied
+        FSHIInventorySlot EmptySlot;
+        EmptySlot.SlotIndex = SlotIndex;
+        OnInventoryChanged.Broadcast(SlotIndex, EmptySlot);
+    }
+}
+
+int32 USHIInventoryComponent::GetUsedSlotCount() const
+{
+    return FMath::Max(0, IndexedSlots.Num() - NumFreeSlots);
+}
+
+void USHIInventoryComponent::SetSlotContents(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity)
+{
+    if (SlotIndex < 0 || SlotIndex >= GetStorageSlots().Num())
+    {
+        return;
+    }
+
+    FSHIInventorySlot& Slot = GetStorageSlots()[SlotIndex];
+    
+    // Journal every write, a nested rollback only replays the writes made after its own marker
+    if (TransactionMarkers.Num() > 0)
+    {
+        FSHISlotJournalEntry& Entry = TransactionJournal.AddDefaulted_GetRef();
+        Entry.SlotIndex = SlotIndex;
+        Entry.Previous.ItemData = Slot.ItemData;
+        Entry.Previous.Quantity = Slot.Quantity;
+    }
+    
+    Slot.SetContents(ItemData, Quantity);
+    UpdateSlotIndex(SlotIndex, Slot.ItemData, Slot.Quantity);
+    
+    if (TransactionMarkers.Num() == 0)
+    {
+        MarkSlotDirty(SlotIndex);
+    }
+}
+
+void USHIInventoryComponent::BeginTransaction()
+{
+    FSHITransactionMarker& Marker = TransactionMarkers.AddDefaulted_GetRef();
+    Marker.JournalStart = TransactionJournal.Num();
+    Marker.PendingAddedStart = PendingItemAdded.Num();
+}
+
+void USHIInventoryComponent::CommitTransaction()
+{
+    if (TransactionMarkers.Num() == 0)
+    {
+        return;
+    }
+    
+    // A nested commit keeps its writes in the journal, the outer transaction can still roll them back
+    TransactionMarkers.Pop(EAllowShrinking::No);
+    if (TransactionMarkers.Num() > 0)
+    {
+        return;
+    }
+    
+    // Only slots whose final contents differ from their first journal entry go over the wire
+    TArray<int32> ChangedSlots;
+    TSet<int32> SeenSlots;
+    SeenSlots.Reserve(TransactionJournal.Num());
+    for (const FSHISlotJournalEntry& Entry : TransactionJournal)
+    {
+        bool bAlreadySeen = false;
+        SeenSlots.Add(Entry.SlotIndex, &bAlreadySeen);
+        if (bAlreadySeen)
+        {
+            continue;
+        }
+        
+        const FSHIInventorySlot& Slot = GetStorageSlots()[Entry.SlotIndex];
+        if (Slot.ItemData != Entry.Previous.ItemData || Slot.Quantity != Entry.Previous.Quantity)
+        {
+            ChangedSlots.Add(Entry.SlotIndex);
+        }
+    }
+    TransactionJournal.Reset();
+    ChangedSlots.Sort();
+    
+    for (int32 SlotIndex : ChangedSlots)
+    {
+        MarkSlotDirty(SlotIndex);
+    }
+    
+    TArray<FSHIPendingItemAdded> ItemsAdded = MoveTemp(PendingItemAdded);
+    PendingItemAdded.Reset();
+    for (const FSHIPendingItemAdded& Added : ItemsAdded)
+    {
+        OnItemAdded.Broadcast(Added.ItemData, Added.Quantity, Added.SlotIndex);
+    }
+}
+
+void USHIInventoryComponent::RollbackTransaction()
+{
+    if (TransactionMarkers.Num() == 0)
     {
-        OnInventoryChanged.Broadcast(SlotIndex, InventorySlots[SlotIndex]);
+        return;
     }
+    
+    // Nothing was marked dirty yet, replaying this transaction's writes backwards is enough
+    const FSHITransactionMarker Marker = TransactionMarkers.Pop(EAllowShrinking::No);
+    for (int32 i = TransactionJournal.Num() - 1; i >= Marker.JournalStart; i--)
+    {
+        const FSHISlotJournalEntry& Entry = TransactionJournal[i];
+        GetStorageSlots()[Entry.SlotIndex].SetContents(Entry.Previous.ItemData, Entry.Previous.Quantity);
+        UpdateSlotIndex(Entry.SlotIndex, Entry.Previous.ItemData, Entry.Previous.Quantity);
+    }
+    
+    TransactionJournal.SetNum(Marker.JournalStart, EAllowShrinking::No);
+    PendingItemAdded.SetNum(Marker.PendingAddedStart, EAllowShrinking::No);
+}
+
+void USHIInventoryComponent::EnsureSlotIndexSize()
+{
+    // Clients can receive slots before BeginPlay, so the index grows on demand
+    const int32 IndexSize = FMath::Max(InventorySize, GetStorageSlots().Num());
+    if (IndexedSlots.Num() < IndexSize)
+    {
+        const int32 Added = IndexSize - IndexedSlots.Num();
+        IndexedSlots.SetNum(IndexSize);
+        FreeSlotBits.Add(true, Added);
+        NumFreeSlots += Added;
+    }
+}
+
+void USHIInventoryComponent::RebuildSlotIndex()
+{
+    ItemStackIndex.Reset();
+    IndexedSlots.Reset();
+    FreeSlotBits.Reset();
+    NumFreeSlots = 0;
+    EnsureSlotIndexSize();
+
+    if (bPagedStorage && GetOwnerRole() == ROLE_Authority)
+    {
+        UsedSlotMask.Init(0, FMath::DivideAndRoundUp(FMath::Max(InventorySize, 1), 32));
+        UsedSlotCount = 0;
+    }
+
+    for (const FSHIInventorySlot& Slot : GetStorageSlots())
+    {
+        UpdateSlotIndex(Slot.SlotIndex, Slot.ItemData, Slot.Quantity);
+    }
+
+    // The window only covers one page, the rest of the free slot picture comes from the server
+    ApplyUsedSlotMask();
+}
+
+void USHIInventoryComponent::UpdateSlotIndex(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity)
+{
+    if (SlotIndex < 0)
+    {
+        return;
+    }
+
+    if (SlotIndex >= IndexedSlots.Num())
+    {
+        EnsureSlotIndexSize();
+        if (SlotIndex >= IndexedSlots.Num())
+        {
+            return;
+        }
+    }
+
+    USHIItemData* NewItem = Quantity > 0 ? ItemData : nullptr;
+    const int32 NewQuantity = NewItem ? Quantity : 0;
+
+    FSHIIndexedSlot& Indexed = IndexedSlots[SlotIndex];
+    if (Indexed.ItemData == NewItem && Indexed.Quantity == NewQuantity)
+    {
+        return;
+    }
+
+    // Take out what the slot used to contribute
+    if (Indexed.ItemData)
+    {
+        if (FSHIItemStackIndex* OldEntry = ItemStackIndex.Find(Indexed.ItemData))
+        {
+            OldEntry->TotalQuantity -= Indexed.Quantity;
+            if (Indexed.ItemData != NewItem)
+            {
+                OldEntry->SlotIndices.RemoveSingleSwap(SlotIndex);
+                if (OldEntry->SlotIndices.Num() == 0)
+                {
+                    ItemStackIndex.Remove(Indexed.ItemData);
+                }
+            }
+        }
+    }
+
+    // Add the new contents
+    if (NewItem)
+    {
+        FSHIItemStackIndex& NewEntry = ItemStackIndex.FindOrAdd(NewItem);
+        NewEntry.TotalQuantity += NewQuantity;
+        if (Indexed.ItemData != NewItem)
+        {
+            NewEntry.SlotIndices.Add(SlotIndex);
+        }
+    }
+
+    const bool bWasFree = Indexed.ItemData == nullptr;
+    const bool bIsFree = NewItem == nullptr;
+    if (bWasFree != bIsFree)
+    {
+        FreeSlotBits[SlotIndex] = bIsFree;
+        NumFreeSlots += bIsFree ? 1 : -1;
+
+        // Mirror the full storage occupancy for the owner of a paged container
+        if (bPagedStorage && GetOwnerRole() == ROLE_Authority && UsedSlotMask.IsValidIndex(SlotIndex / 32))
+        {
+            const uint32 Bit = 1u << (SlotIndex % 32);
+            if (bIsFree)
+            {
+                UsedSlotMask[SlotIndex / 32] &= ~Bit;
+            }
+            else
+            {
+                UsedSlotMask[SlotIndex / 32] |= Bit;
+            }
+            UsedSlotCount += bIsFree ? -1 : 1;
+        }
+    }
+
+    Indexed.ItemData = NewItem;
+    Indexed.Quantity = NewQuantity;
 }
\ No newline at end of file
@@ -3,12 +3,16 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "Data/SHIItemData.h"
 #include "SHIInventoryComponent.generated.h"
 
-// Inventory slot structure
+class USHIInventoryComponent;
+struct FSHIInventoryList;
+
+// Inventory slot structure (fast array item - only dirty slots are replicated)
 USTRUCT(BlueprintType)
-struct FSHIInventorySlot
+struct FSHIInventorySlot : public FFastArraySerializerItem
 {
     GENERATED_BODY()
 
@@ -18,10 +22,15 @@ struct FSHIInventorySlot
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
     int32 Quantity = 0;
 
+    // Position of this slot in the inventory, assigned once by the server
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 SlotIndex = INDEX_NONE;
+
     FSHIInventorySlot()
     {
         ItemData = nullptr;
         Quantity = 0;
+        SlotIndex = INDEX_NONE;
     }
     
     bool IsEmpty() const
@@ -33,10 +42,184 @@ struct FSHIInventorySlot
     {
         return ItemData == OtherItem && ItemData && ItemData->IsStackable();
     }
+
+    // Only touches the item contents - replication IDs and SlotIndex stay with the slot
+    void SetContents(USHIItemData* InItemData, int32 InQuantity)
+    {
+        ItemData = InQuantity > 0 ? InItemData : nullptr;
+        Quantity = ItemData ? InQuantity : 0;
+    }
+
+    void Clear() { SetContents(nullptr, 0); }
+
+    // Compact wire format - registry item id plus packed quantity and slot index
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    // Fast array callbacks (client side, called only for the slots that changed)
+    void PreReplicatedRemove(const FSHIInventoryList& InArraySerializer);
+    void PostReplicatedAdd(const FSHIInventoryList& InArraySerializer);
+    void PostReplicatedChange(const FSHIInventoryList& InArraySerializer);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSHIInventorySlot> : public TStructOpsTypeTraitsBase2<FSHIInventorySlot>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
+// Delta replicated slot container
+USTRUCT()
+struct FSHIInventoryList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FSHIInventorySlot> Items;
+
+    // Owning component, used to route per-slot replication callbacks
+    UPROPERTY(NotReplicated)
+    USHIInventoryComponent* OwnerComponent = nullptr;
+
+    // Called once after each replication update, after all per-slot callbacks
+    void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FSHIInventorySlot, FSHIInventoryList>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FSHIInventoryList> : public TStructOpsTypeTraitsBase2<FSHIInventoryList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+// Batched inventory operation types
+UENUM(BlueprintType)
+enum class ESHIInventoryOpType : uint8
+{
+    Add         UMETA(DisplayName = "Ekle"),          // Add item
+    Remove      UMETA(DisplayName = "Çıkar"),         // Remove item
+    Move        UMETA(DisplayName = "Taşı")           // Move slot
+};
+
+// Auto-sort orders
+UENUM(BlueprintType)
+enum class ESHIInventorySortMode : uint8
+{
+    ByType      UMETA(DisplayName = "Türe Göre"),     // Item type, then rarity
+    ByRarity    UMETA(DisplayName = "Nadirliğe Göre"), // Rarity, then type
+    ByValue     UMETA(DisplayName = "Değere Göre")    // Gold value
+};
+
+// One step of a batched inventory change (quest reward, craft, vendor trade)
+USTRUCT(BlueprintType)
+struct FSHIInventoryOp
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    ESHIInventoryOpType OpType = ESHIInventoryOpType::Add;
+
+    // Add: item to add. Remove: item to take (any stack) or the expected item of SlotIndex
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    USHIItemData* ItemData = nullptr;
+
+    // Move: items to move, 0 = as much of the stack as fits (merge / swap)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    int32 Quantity = 1;
+
+    // Add: target slot (INDEX_NONE = wherever it fits). Remove: source slot (INDEX_NONE = any stack of ItemData). Move: source slot
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    int32 SlotIndex = INDEX_NONE;
+
+    // Move: target slot
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    int32 TargetSlotIndex = INDEX_NONE;
+};
+
+// One slot of an add plan
+USTRUCT(BlueprintType)
+struct FSHIAddPlanEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 SlotIndex = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 Quantity = 0;
+};
+
+// Result of a capacity check - how much fits and where it would go
+USTRUCT(BlueprintType)
+struct FSHIAddPlan
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    USHIItemData* ItemData = nullptr;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 RequestedQuantity = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 FitQuantity = 0;
+
+    // Existing stacks first, then new stacks in empty slots
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    TArray<FSHIAddPlanEntry> Entries;
+
+    bool FitsAll() const { return FitQuantity >= RequestedQuantity; }
+};
+
+// Runtime index entry - every slot holding one item and their summed quantity
+struct FSHIItemStackIndex
+{
+    TArray<int32, TInlineAllocator<4>> SlotIndices;
+    int32 TotalQuantity = 0;
+};
+
+// Slot contents as last seen by the index, used to diff each mutation
+struct FSHIIndexedSlot
+{
+    USHIItemData* ItemData = nullptr;
+    int32 Quantity = 0;
+};
+
+// Slot contents before one transactional write, replayed backwards on rollback
+struct FSHISlotJournalEntry
+{
+    int32 SlotIndex = INDEX_NONE;
+    FSHIIndexedSlot Previous;
+};
+
+// Where a (possibly nested) transaction started in the journals
+struct FSHITransactionMarker
+{
+    int32 JournalStart = 0;
+    int32 PendingAddedStart = 0;
+};
+
+// OnItemAdded event held back until its transaction commits
+struct FSHIPendingItemAdded
+{
+    USHIItemData* ItemData = nullptr;
+    int32 Quantity = 0;
+    int32 SlotIndex = INDEX_NONE;
 };
 
 // Events for UI updates
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryChanged, int32, SlotIndex, const FSHIInventorySlot&, NewSlot);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventorySlotsChanged, const TArray<int32>&, SlotIndices);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryPageChanged, int32, Page);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnItemAdded, USHIItemData*, Item, int32, Quantity, int32, SlotIndex);
 
 UCLASS(ClassGroup=(SHI), meta=(BlueprintSpawnableComponent))
@@ -51,8 +234,26 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Settings")
     int32 InventorySize = 30;  // Standard MMO inventory size
     
-    UPROPERTY(ReplicatedUsing = OnRep_InventorySlots, BlueprintReadOnly, Category = "Inventory")
-    TArray<FSHIInventorySlot> InventorySlots;
+    // Bank / vault mode - the server keeps every slot, the owner only receives the page it is viewing
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Settings")
+    bool bPagedStorage = false;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Settings", meta = (EditCondition = "bPagedStorage", ClampMin = "1"))
+    int32 PageSize = 30;
+    
+    // Delta replicated slots - only touched slots go over the wire (viewed page only in paged mode)
+    UPROPERTY(Replicated)
+    FSHIInventoryList InventoryList;
+    
+    UPROPERTY(ReplicatedUsing = OnRep_ViewedPage, BlueprintReadOnly, Category = "Inventory")
+    int32 ViewedPage = 0;
+
+    // Paged mode: one bit per storage slot (set = used), so the owner knows about slots outside the viewed page
+    UPROPERTY(ReplicatedUsing = OnRep_UsedSlotMask)
+    TArray<uint32> UsedSlotMask;
+
+    UPROPERTY(Replicated)
+    int32 UsedSlotCount = 0;
 
     // Core inventory functions
     UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
@@ -67,10 +268,48 @@ public:
     UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
     void Server_UseItem(int32 SlotIndex);
 
+    // Moves part of a stack - into an empty slot or onto the same item, MaxStackSize is enforced
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
+    void Server_MoveItemQuantity(int32 FromSlot, int32 ToSlot, int32 Quantity);
+
+    // Splits Quantity off a stack, TargetSlot = -1 uses the first empty slot
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
+    void Server_SplitStack(int32 SlotIndex, int32 Quantity, int32 TargetSlot = -1);
+
+    // Moves as much of FromSlot onto ToSlot as the stack limit allows
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
+    void Server_MergeStacks(int32 FromSlot, int32 ToSlot);
+
+    // Merges partial stacks and orders the slots in one pass, only changed slots replicate
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
+    void Server_SortInventory(ESHIInventorySortMode SortMode);
+
+    // Streams another page of a paged container to the owner
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
+    void Server_SetViewedPage(int32 Page);
+
+    // Client rearranging - Move operations only (move, split, merge), all or none of them in one RPC.
+    // Adds and removes come from server code through ApplyBatch.
+    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Inventory")
+    void Server_ApplyBatch(const TArray<FSHIInventoryOp>& Operations);
+
+    // Server side version for quest, crafting and vendor code, returns false if the batch was rolled back
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+    bool ApplyBatch(const TArray<FSHIInventoryOp>& Operations);
+
+    // Adds as much as fits right away and returns the added amount (server only, partial pickups)
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+    int32 TryAddItem(USHIItemData* ItemData, int32 Quantity = 1);
+
     // Query functions
     UFUNCTION(BlueprintPure, Category = "Inventory")
     bool CanAddItem(USHIItemData* ItemData, int32 Quantity = 1) const;
     
+    // Single pass capacity check - how many units fit and which slots they would go to.
+    // A paged client only sees stacks on the viewed page, so it may under-estimate; the server's plan decides.
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    FSHIAddPlan PlanAddItem(USHIItemData* ItemData, int32 Quantity = 1) const;
+    
     UFUNCTION(BlueprintPure, Category = "Inventory")
     int32 GetItemCount(USHIItemData* ItemData) const;
     
@@ -83,6 +322,26 @@ public:
     UFUNCTION(BlueprintPure, Category = "Inventory")
     int32 FindItemSlot(USHIItemData* ItemData) const;
 
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    int32 GetFreeSlotCount() const { return NumFreeSlots; }
+
+    // O(1) from the free slot index - paged clients use the replicated used count
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    int32 GetUsedSlotCount() const;
+
+    // Replicated slots - on a paged client this is only the viewed page
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    const TArray<FSHIInventorySlot>& GetAllSlots() const { return InventoryList.Items; }
+
+    // Every slot the server stores (all pages), on a client the same as GetAllSlots
+    const TArray<FSHIInventorySlot>& GetStoredSlots() const { return GetStorageSlots(); }
+
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    int32 GetPageCount() const;
+
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    int32 GetSlotsPerPage() const;
+
     // Events
     UPROPERTY(BlueprintAssignable, Category = "Events")
     FOnInventoryChanged OnInventoryChanged;
@@ -90,15 +349,81 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Events")
     FOnItemAdded OnItemAdded;
 
+    // Fired once per frame with every slot that changed in it (OnInventoryChanged already fired per slot as each change happened)
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnInventorySlotsChanged OnInventorySlotsChanged;
+
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnInventoryPageChanged OnInventoryPageChanged;
+
 protected:
     virtual void BeginPlay() override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
     
     UFUNCTION()
-    void OnRep_InventorySlots();
+    void OnRep_ViewedPage();
+
+    UFUNCTION()
+    void OnRep_UsedSlotMask();
+
+    // Paged client: free slot bits come from the replicated mask instead of the page window
+    void ApplyUsedSlotMask();
     
     // Internal helper functions
     void InitializeInventory();
-    bool AddItemToSlot(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity);
+    void RefreshPageWindow();
+    TArray<FSHIInventorySlot>& GetStorageSlots();
+    const TArray<FSHIInventorySlot>& GetStorageSlots() const;
+    const FSHIInventorySlot* FindSlot(int32 SlotIndex) const;
+    void MarkSlotDirty(int32 SlotIndex);
     void BroadcastSlotChange(int32 SlotIndex);
+
+    // Per slot events fire immediately, the aggregate is collected in a dirty set and flushed once per frame
+    void QueueSlotChange(int32 SlotIndex);
+    void FlushSlotChanges();
+
+    // All server side slot writes go through here so the index stays in sync
+    void SetSlotContents(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity);
+
+    // Item -> stacks index and free slot bitset, updated on every mutation
+    void RebuildSlotIndex();
+    void UpdateSlotIndex(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity);
+    void EnsureSlotIndexSize();
+
+    // Server side storage of a paged container (never replicated)
+    UPROPERTY()
+    TArray<FSHIInventorySlot> PagedStorage;
+
+    TMap<USHIItemData*, FSHIItemStackIndex> ItemStackIndex;
+    TArray<FSHIIndexedSlot> IndexedSlots;
+    TBitArray<> FreeSlotBits;  // true = slot is empty
+    int32 NumFreeSlots = 0;
+
+    // One marker per open transaction, the journal is shared by all of them
+    TArray<FSHITransactionMarker> TransactionMarkers;
+    TArray<FSHISlotJournalEntry> TransactionJournal;
+    TArray<FSHIPendingItemAdded> PendingItemAdded;
+    TSet<int32> PendingChangedSlots;
+    bool bSlotFlushScheduled = false;
+
+    // Called from the fast array callbacks on clients
+    void HandleReplicatedSlotChange(const FSHIInventorySlot& Slot);
+    void HandleReplicatedReceive();
+
+    // Transactions - slot writes are journaled, dirty marking and events wait for the outermost commit
+    void BeginTransaction();
+    void CommitTransaction();
+    void RollbackTransaction();
+
+    // Mutation helpers, callers wrap them in a transaction
+    int32 AddItemInternal(USHIItemData* ItemData, int32 Quantity);
+    bool AddToSlotInternal(int32 SlotIndex, USHIItemData* ItemData, int32 Quantity);
+    int32 PlanAddItemInternal(USHIItemData* ItemData, int32 Quantity, TArray<FSHIAddPlanEntry>* OutEntries) const;
+    void ApplyAddPlan(const FSHIAddPlan& Plan);
+    int32 RemoveFromSlotInternal(int32 SlotIndex, int32 Quantity);
+    bool RemoveItemInternal(USHIItemData* ItemData, int32 Quantity);
+    bool MoveItemInternal(int32 FromSlot, int32 ToSlot, int32 Quantity);
+    bool ApplyOperation(const FSHIInventoryOp& Operation);
+
+    friend struct FSHIInventorySlot;
 };
\ No newline at end of file
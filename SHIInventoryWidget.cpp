@@ -31,8 +31,9 @@ void USHIInventoryWidget::SetOwnerCharacter(ASHICharacter* Character)
         
         if (InventoryComponent)
         {
-            // Bind to inventory change events
-            InventoryComponent->OnInventoryChanged.AddDynamic(this, &USHIInventoryWidget::OnInventoryChanged);
+            // Bind to the coalesced change event - one UI update per inventory change, however many slots
+            InventoryComponent->OnInventorySlotsChanged.AddDynamic(this, &USHIInventoryWidget::OnInventorySlotsChanged);
+            InventoryComponent->OnInventoryPageChanged.AddDynamic(this, &USHIInventoryWidget::OnInventoryPageChanged);
             
             // Initialize the grid
             InitializeInventoryGrid();
@@ -63,6 +64,13 @@ void USHIInventoryWidget::InitializeInventoryGrid()
         return;
     }
     
+    if (InventoryComponent)
+    {
+        TotalSlots = InventoryComponent->InventorySize;
+        SlotsPerPage = InventoryComponent->GetSlotsPerPage();
+        CurrentPage = InventoryComponent->ViewedPage;
+    }
+    
     CreateSlotWidgets();
     RefreshInventoryDisplay();
     
@@ -78,13 +86,13 @@ void USHIInventoryWidget::CreateSlotWidgets()
     InventoryGrid->ClearChildren();
     SlotWidgets.Empty();
     
-    // Create slot widgets
-    for (int32 i = 0; i < TotalSlots; i++)
+    // Create slot widgets - one page worth, reused when the page changes
+    for (int32 i = 0; i < SlotsPerPage; i++)
     {
         USHIInventorySlotWidget* SlotWidget = CreateWidget<USHIInventorySlotWidget>(this, SlotWidgetClass);
         if (SlotWidget)
         {
-            SlotWidget->SetSlotIndex(i);
+            SlotWidget->SetSlotIndex(GetFirstDisplayedSlot() + i);
             SlotWidget->SetOwnerInventory(this);
             
             // Calculate grid position
@@ -116,10 +124,16 @@ void USHIInventoryWidget::RefreshInventoryDisplay()
     }
     
     // Update all slot widgets
-    for (int32 i = 0; i < SlotWidgets.Num() && i < TotalSlots; i++)
+    const int32 FirstSlot = GetFirstDisplayedSlot();
+    for (int32 i = 0; i < SlotWidgets.Num(); i++)
     {
-        FSHIInventorySlot SlotData = InventoryComponent->GetSlot(i);
-        UpdateSlotWidget(i, SlotData);
+        if (SlotWidgets[i] && SlotWidgets[i]->GetSlotIndex() != FirstSlot + i)
+        {
+            SlotWidgets[i]->SetSlotIndex(FirstSlot + i);
+        }
+        
+        FSHIInventorySlot SlotData = InventoryComponent->GetSlot(FirstSlot + i);
+        UpdateSlotWidget(FirstSlot + i, SlotData);
     }
     
     UE_LOG(LogTemp, Log, TEXT("Refreshed %d inventory slots"), SlotWidgets.Num());
@@ -127,9 +141,10 @@ void USHIInventoryWidget::RefreshInventoryDisplay()
 
 void USHIInventoryWidget::UpdateSlotWidget(int32 SlotIndex, const FSHIInventorySlot& SlotData)
 {
-    if (SlotIndex >= 0 && SlotIndex < SlotWidgets.Num())
+    const int32 WidgetIndex = SlotIndex - GetFirstDisplayedSlot();
+    if (WidgetIndex >= 0 && WidgetIndex < SlotWidgets.Num())
     {
-        USHIInventorySlotWidget* SlotWidget = SlotWidgets[SlotIndex];
+        USHIInventorySlotWidget* SlotWidget = SlotWidgets[WidgetIndex];
         if (SlotWidget)
         {
             SlotWidget->UpdateSlotData(SlotData);
@@ -149,19 +164,28 @@ void USHIInventoryWidget::UpdateSlotWidget(int32 SlotIndex, const FSHIInventoryS
     }
 }
 
-void USHIInventoryWidget::OnInventoryChanged(int32 SlotIndex, const FSHIInventorySlot& NewSlot)
+void USHIInventoryWidget::OnInventorySlotsChanged(const TArray<int32>& SlotIndices)
 {
-    // Update specific slot
-    UpdateSlotWidget(SlotIndex, NewSlot);
+    if (!InventoryComponent)
+        return;
+    
+    const int32 FirstSlot = GetFirstDisplayedSlot();
+    for (int32 SlotIndex : SlotIndices)
+    {
+        // Slots on other pages are not displayed
+        if (SlotIndex >= FirstSlot && SlotIndex < FirstSlot + SlotWidgets.Num())
+        {
+            UpdateSlotWidget(SlotIndex, InventoryComponent->GetSlot(SlotIndex));
+        }
+    }
     
-    UE_LOG(LogTemp, Log, TEXT("Inventory slot %d updated in UI: %s"), 
-           SlotIndex,
-           NewSlot.IsEmpty() ? TEXT("Empty") : *NewSlot.ItemData->ItemName.ToString());
+    UE_LOG(LogTemp, Log, TEXT("%d inventory slots updated in UI"), SlotIndices.Num());
     
     // Show inventory status update on screen
     if (GEngine)
     {
         int32 UsedSlots = GetUsedSlots();
+        // Used count covers the whole storage, so divide by all slots rather than the page
         FString StatusText = FString::Printf(TEXT("Envanter: %d/%d"), UsedSlots, TotalSlots);
         GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Cyan, StatusText);
     }
@@ -172,24 +196,45 @@ int32 USHIInventoryWidget::GetUsedSlots() const
     if (!InventoryComponent)
         return 0;
     
-    int32 UsedCount = 0;
-    for (int32 i = 0; i < TotalSlots; i++)
-    {
-        if (!InventoryComponent->GetSlot(i).IsEmpty())
-        {
-            UsedCount++;
-        }
-    }
-    
-    return UsedCount;
+    // Read from the component's free slot index instead of copying every slot
+    return InventoryComponent->GetUsedSlotCount();
 }
 
 USHIInventorySlotWidget* USHIInventoryWidget::GetSlotWidget(int32 SlotIndex) const
 {
-    if (SlotIndex >= 0 && SlotIndex < SlotWidgets.Num())
+    const int32 WidgetIndex = SlotIndex - GetFirstDisplayedSlot();
+    if (WidgetIndex >= 0 && WidgetIndex < SlotWidgets.Num())
     {
-        return SlotWidgets[SlotIndex];
+        return SlotWidgets[WidgetIndex];
     }
     
     return nullptr;
+}
+
+void USHIInventoryWidget::OnInventoryPageChanged(int32 Page)
+{
+    CurrentPage = Page;
+    RefreshInventoryDisplay();
+    
+    if (GEngine && InventoryComponent)
+    {
+        FString PageText = FString::Printf(TEXT("Sayfa: %d/%d"), CurrentPage + 1, InventoryComponent->GetPageCount());
+        GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Cyan, PageText);
+    }
+}
+
+void USHIInventoryWidget::NextPage()
+{
+    if (InventoryComponent && CurrentPage + 1 < InventoryComponent->GetPageCount())
+    {
+        InventoryComponent->Server_SetViewedPage(CurrentPage + 1);
+    }
+}
+
+void USHIInventoryWidget::PreviousPage()
+{
+    if (InventoryComponent && CurrentPage > 0)
+    {
+        InventoryComponent->Server_SetViewedPage(CurrentPage - 1);
+    }
 }
\ No newline at end of file
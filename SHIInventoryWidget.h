@@ -49,7 +49,20 @@ public:
 
     // Event handlers
     UFUNCTION()
-    void OnInventoryChanged(int32 SlotIndex, const FSHIInventorySlot& NewSlot);
+    void OnInventorySlotsChanged(const TArray<int32>& SlotIndices);
+
+    UFUNCTION()
+    void OnInventoryPageChanged(int32 Page);
+
+    // Page navigation (paged bank / vault containers)
+    UFUNCTION(BlueprintCallable, Category = "Inventory UI")
+    void NextPage();
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory UI")
+    void PreviousPage();
+
+    UFUNCTION(BlueprintPure, Category = "Inventory UI")
+    int32 GetCurrentPage() const { return CurrentPage; }
 
     // Getters
     UFUNCTION(BlueprintPure, Category = "Inventory UI")
@@ -65,9 +78,14 @@ protected:
     // Grid setup
     void CreateSlotWidgets();
     void UpdateSlotWidget(int32 SlotIndex, const FSHIInventorySlot& SlotData);
+    int32 GetFirstDisplayedSlot() const { return CurrentPage * SlotsPerPage; }
 
     // Constants
     static constexpr int32 GridColumns = 8;
     static constexpr int32 GridRows = 4;
-    static constexpr int32 TotalSlots = 30;
+
+    // Sizes come from the bound inventory component
+    int32 TotalSlots = 30;
+    int32 SlotsPerPage = 30;
+    int32 CurrentPage = 0;
 };
\ No newline at end of file
@@ -1,4 +1,178 @@
 ﻿#include "SHIItemData.h"
+#include "Data/SHIItemRegistry.h"
 
-// Constructor implementation for any initialization if needed
-// Currently no additional implementation required as all functionality is in the header
\ No newline at end of file
+bool FSHIEquipmentSlot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    USHIItemRegistry::NetSerializeItem(Ar, Map, ItemData);
+
+    uint32 PackedQuantity = FMath::Max(Quantity, 0);
+    Ar.SerializeIntPacked(PackedQuantity);
+    if (Ar.IsLoading())
+    {
+        Quantity = static_cast<int32>(PackedQuantity);
+    }
+
+    bOutSuccess = true;
+    return true;
+}
+
+// Built once, comparing against these is an index compare
+static const FName* GetStatNameTable()
+{
+    static const FName StatNames[] =
+    {
+        FName(TEXT("Guc")),
+        FName(TEXT("Ceviklik")),
+        FName(TEXT("Zeka")),
+        FName(TEXT("Odaklanma")),
+        FName(TEXT("Dayaniklilik"))
+    };
+    static_assert(UE_ARRAY_COUNT(StatNames) == (int32)ESHIStatType::Max, "Stat names must match ESHIStatType");
+    return StatNames;
+}
+
+ESHIStatType FSHIStatModifier::ResolveStatName(FName InStatName)
+{
+    const FName* StatNames = GetStatNameTable();
+    for (int32 i = 0; i < (int32)ESHIStatType::Max; i++)
+    {
+        if (StatNames[i] == InStatName)
+        {
+            return static_cast<ESHIStatType>(i);
+        }
+    }
+    return ESHIStatType::Max;
+}
+
+FName FSHIStatModifier::GetStatName(ESHIStatType Stat)
+{
+    return Stat < ESHIStatType::Max ? GetStatNameTable()[(uint8)Stat] : NAME_None;
+}
+
+void USHIItemData::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // Items created at runtime never get PostLoad - build from the initial properties
+    BuildStatVector();
+    ResolveTraits();
+}
+
+void USHIItemData::PostLoad()
+{
+    Super::PostLoad();
+
+    for (FSHIStatModifier& Bonus : StatBonuses)
+    {
+        Bonus.ResolveStat();
+        if (Bonus.StatType == ESHIStatType::Max && Bonus.StatName != NAME_None)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Item %s has a bonus on unknown stat %s"), *GetName(), *Bonus.StatName.ToString());
+        }
+    }
+
+    BuildStatVector();
+    ResolveTraits();
+}
+
+void USHIItemData::ResolveTraits()
+{
+    ResolvedTraits = static_cast<ESHIItemTraits>(ItemTraits);
+    if (ResolvedTraits != ESHIItemTraits::None)
+    {
+        return;
+    }
+
+    // Legacy assets - guessed from the asset name, which unlike the display name is not localized
+    // (Contains ignores case)
+    const FString Name = GetName();
+    if (ItemType == ESHIItemType::Silah)
+    {
+        const bool bShieldName = Name.Contains(TEXT("Kalkan")) || Name.Contains(TEXT("Shield")) || Name.Contains(TEXT("Buckler"));
+        if (bShieldName)
+        {
+            ResolvedTraits |= ESHIItemTraits::Kalkan;
+        }
+        else if (Name.Contains(TEXT("Kilic")) || Name.Contains(TEXT("Sword")) ||
+                 Name.Contains(TEXT("Saber")) || Name.Contains(TEXT("Sabre")))
+        {
+            ResolvedTraits |= ESHIItemTraits::Kilic;
+        }
+        else if (Name.Contains(TEXT("Balta")) || Name.Contains(TEXT("Axe")))
+        {
+            ResolvedTraits |= ESHIItemTraits::Balta;
+        }
+        else if (Name.Contains(TEXT("Mec")) || Name.Contains(TEXT("Rapier")))
+        {
+            ResolvedTraits |= ESHIItemTraits::Mec;
+        }
+        else if (Name.Contains(TEXT("Ates")) || Name.Contains(TEXT("Fire")) || Name.Contains(TEXT("Asa")))
+        {
+            ResolvedTraits |= ESHIItemTraits::AtesAsasi;
+        }
+    }
+    else if (ItemType == ESHIItemType::Tuketim)
+    {
+        // Mana first - "Mana Potion" is not a health potion
+        if (Name.Contains(TEXT("Mana")) || Name.Contains(TEXT("Enerji")) || Name.Contains(TEXT("Energy")))
+        {
+            ResolvedTraits |= ESHIItemTraits::EnerjiIksiri;
+        }
+        else if (Name.Contains(TEXT("Potion")) || Name.Contains(TEXT("Iksir")) || Name.Contains(TEXT("Health")) || Name.Contains(TEXT("Saglik")))
+        {
+            ResolvedTraits |= ESHIItemTraits::SaglikIksiri;
+        }
+    }
+
+    if (ResolvedTraits != ESHIItemTraits::None)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Item %s has no traits set - guessed 0x%x from its name"), *GetName(), (uint32)ResolvedTraits);
+    }
+}
+
+float USHIItemData::GetRestoreAmount() const
+{
+    if (RestoreAmount > 0.0f)
+    {
+        return RestoreAmount;
+    }
+
+    // Amounts the hotbar used before they were item data
+    if (HasTrait(ESHIItemTraits::SaglikIksiri))
+    {
+        return 50.0f;
+    }
+    if (HasTrait(ESHIItemTraits::EnerjiIksiri))
+    {
+        return 30.0f;
+    }
+    return 0.0f;
+}
+
+void USHIItemData::BuildStatVector()
+{
+    StatVector = FSHIStatVector();
+    for (const FSHIStatModifier& Bonus : StatBonuses)
+    {
+        const ESHIStatType Stat = Bonus.GetStatType();
+        if (Stat != ESHIStatType::Max)
+        {
+            StatVector.Values[(uint8)Stat] += Bonus.BonusAmount;
+        }
+    }
+}
+
+#if WITH_EDITOR
+void USHIItemData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    for (FSHIStatModifier& Bonus : StatBonuses)
+    {
+        Bonus.ResolveStat();
+    }
+
+    BuildStatVector();
+    ResolveTraits();
+}
+#endif
\ No newline at end of file
@@ -43,6 +43,45 @@ enum class ESHIItemType : uint8
     Ozel        UMETA(DisplayName = "Özel")           // Special
 };
 
+// Item rarity tiers
+UENUM(BlueprintType)
+enum class ESHIItemRarity : uint8
+{
+    Siradan     UMETA(DisplayName = "Sıradan"),       // Common
+    Nadir       UMETA(DisplayName = "Nadir"),         // Rare
+    Destansi    UMETA(DisplayName = "Destansı"),      // Epic
+    Efsanevi    UMETA(DisplayName = "Efsanevi")       // Legendary
+};
+
+// Gameplay classification of an item, checked instead of the item's display name
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ESHIItemTraits : uint8
+{
+    None            = 0 UMETA(Hidden),
+    Kilic           = 1 << 0 UMETA(DisplayName = "Kılıç"),          // Sword
+    Balta           = 1 << 1 UMETA(DisplayName = "Balta"),          // Axe
+    Mec             = 1 << 2 UMETA(DisplayName = "Meç"),            // Rapier
+    AtesAsasi       = 1 << 3 UMETA(DisplayName = "Ateş Asası"),     // Fire staff
+    Kalkan          = 1 << 4 UMETA(DisplayName = "Kalkan"),         // Shield
+    IkiElli         = 1 << 5 UMETA(DisplayName = "İki Elli"),       // Two-handed
+    SaglikIksiri    = 1 << 6 UMETA(DisplayName = "Sağlık İksiri"),  // Health potion
+    EnerjiIksiri    = 1 << 7 UMETA(DisplayName = "Enerji İksiri")   // Mana potion
+};
+ENUM_CLASS_FLAGS(ESHIItemTraits);
+
+// Core character stats - order matches the float layout of FSHICharacterStats
+UENUM(BlueprintType)
+enum class ESHIStatType : uint8
+{
+    Guc             UMETA(DisplayName = "Güç"),           // Strength
+    Ceviklik        UMETA(DisplayName = "Çeviklik"),      // Dexterity
+    Zeka            UMETA(DisplayName = "Zeka"),          // Intelligence
+    Odaklanma       UMETA(DisplayName = "Odaklanma"),     // Focus
+    Dayaniklilik    UMETA(DisplayName = "Dayanıklılık"),  // Constitution
+    
+    Max UMETA(Hidden)
+};
+
 // Equipment slots for Turkish MMO (UI Design Based)
 UENUM(BlueprintType)
 enum class ESHIEquipmentSlot : uint8
@@ -75,11 +114,57 @@ struct FSHIStatModifier
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Bonus")
     float BonusAmount = 0.0f;
 
+    // StatName resolved once when the owning item loads, Max until then
+    ESHIStatType StatType = ESHIStatType::Max;
+
     FSHIStatModifier()
     {
         StatName = FName("None");
         BonusAmount = 0.0f;
     }
+
+    void ResolveStat() { StatType = ResolveStatName(StatName); }
+
+    // Modifiers built at runtime (not loaded with an item) fall back to the name lookup
+    ESHIStatType GetStatType() const { return StatType != ESHIStatType::Max ? StatType : ResolveStatName(StatName); }
+
+    // ESHIStatType::Max if the name is not a stat
+    static ESHIStatType ResolveStatName(FName InStatName);
+
+    static FName GetStatName(ESHIStatType Stat);
+};
+
+// Dense per stat totals, indexed by ESHIStatType
+struct FSHIStatVector
+{
+    float Values[(uint8)ESHIStatType::Max] = {};
+
+    float operator[](ESHIStatType Stat) const { return Values[(uint8)Stat]; }
+
+    FSHIStatVector& operator+=(const FSHIStatVector& Other)
+    {
+        for (int32 i = 0; i < (int32)ESHIStatType::Max; i++)
+        {
+            Values[i] += Other.Values[i];
+        }
+        return *this;
+    }
+
+    FSHIStatVector& operator-=(const FSHIStatVector& Other)
+    {
+        for (int32 i = 0; i < (int32)ESHIStatType::Max; i++)
+        {
+            Values[i] -= Other.Values[i];
+        }
+        return *this;
+    }
+
+    bool operator==(const FSHIStatVector& Other) const
+    {
+        return FMemory::Memcmp(Values, Other.Values, sizeof(Values)) == 0;
+    }
+
+    bool operator!=(const FSHIStatVector& Other) const { return !(*this == Other); }
 };
 
 // Weapon Ability data structure for data-driven abilities
@@ -136,6 +221,9 @@ struct FSHIEquipmentSlot
     bool IsEmpty() const { return ItemData == nullptr || Quantity <= 0; }
     void Clear() { ItemData = nullptr; Quantity = 0; }
     
+    // Compact wire format - registry item id plus packed quantity
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+    
     FSHIEquipmentSlot()
     {
         ItemData = nullptr;
@@ -143,6 +231,15 @@ struct FSHIEquipmentSlot
     }
 };
 
+template<>
+struct TStructOpsTypeTraits<FSHIEquipmentSlot> : public TStructOpsTypeTraitsBase2<FSHIEquipmentSlot>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
 UCLASS(BlueprintType)
 class STILLHEREISTANBUL_API USHIItemData : public UPrimaryDataAsset
 {
@@ -168,6 +265,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
     int32 ItemValue = 0;  // Gold value
 
+    // Left empty on older assets - those get their traits guessed from the item name once at load
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info", meta = (Bitmask, BitmaskEnum = "/Script/StillHereIstanbul.ESHIItemTraits"))
+    int32 ItemTraits = 0;
+
     // Equipment Properties (Updated for new slots)
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Equipment", 
               meta = (EditCondition = "ItemType == ESHIItemType::Silah || ItemType == ESHIItemType::Zirh || ItemType == ESHIItemType::Aksesuar"))
@@ -177,11 +278,19 @@ public:
               meta = (EditCondition = "ItemType == ESHIItemType::Silah || ItemType == ESHIItemType::Zirh || ItemType == ESHIItemType::Aksesuar"))
     TArray<FSHIStatModifier> StatBonuses;
 
+    // Consumables - how much a potion (SaglikIksiri / EnerjiIksiri trait) restores, 0 uses the default for its trait
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Consumable", 
+              meta = (EditCondition = "ItemType == ESHIItemType::Tuketim", ClampMin = "0"))
+    float RestoreAmount = 0.0f;
+
     // 3D Model for world representation
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
     UStaticMesh* WorldMesh;
 
     // Istanbul flavor - item rarity
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+    ESHIItemRarity Rarity = ESHIItemRarity::Siradan;
+
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
     FLinearColor RarityColor = FLinearColor::White;
 
@@ -191,6 +300,28 @@ public:
     TArray<FSHIWeaponAbility> WeaponAbilities;
 
 public:
+    virtual void PostInitProperties() override;
+    virtual void PostLoad() override;
+
+    // ItemTraits, or the name based guess for assets that never had them set - resolved at init, load and edit
+    ESHIItemTraits GetTraits() const { return ResolvedTraits; }
+
+    bool HasTrait(ESHIItemTraits Trait) const { return EnumHasAnyFlags(GetTraits(), Trait); }
+
+    UFUNCTION(BlueprintPure, Category = "Item Info")
+    bool HasItemTrait(ESHIItemTraits Trait) const { return HasTrait(Trait); }
+
+    // RestoreAmount, or the old fixed potion amounts (50 health / 30 energy) for assets that never set it
+    UFUNCTION(BlueprintPure, Category = "Item Info")
+    float GetRestoreAmount() const;
+
+    // StatBonuses summed per stat - built at init, load and edit, so equipping is a vector add
+    const FSHIStatVector& GetStatVector() const { return StatVector; }
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
     // Data Asset ID for networking
     virtual FPrimaryAssetId GetPrimaryAssetId() const override
     {
@@ -249,8 +380,7 @@ public:
                 return ItemType == ESHIItemType::Silah;
                 
             case ESHIEquipmentSlot::Kalkan:
-                return ItemType == ESHIItemType::Silah && 
-                       ItemName.ToString().Contains(TEXT("Kalkan"));
+                return ItemType == ESHIItemType::Silah && HasTrait(ESHIItemTraits::Kalkan);
                        
             case ESHIEquipmentSlot::Kolye:
             case ESHIEquipmentSlot::Yuzuk:
@@ -279,4 +409,12 @@ public:
             return WeaponAbilities[Index];
         return FSHIWeaponAbility();
     }
+
+protected:
+    void BuildStatVector();
+    void ResolveTraits();
+
+    ESHIItemTraits ResolvedTraits = ESHIItemTraits::None;
+
+    FSHIStatVector StatVector;
 };
\ No newline at end of file
@@ -0,0 +1,178 @@
+﻿#include "SHIItemOwnershipComponent.h"
+#include "Components/SHIEquipmentComponent.h"
+#include "Engine/Engine.h"
+
+USHIItemOwnershipComponent::USHIItemOwnershipComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+
+    InventoryComponent = nullptr;
+    EquipmentComponent = nullptr;
+    HotbarComponent = nullptr;
+}
+
+void USHIItemOwnershipComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (AActor* Owner = GetOwner())
+    {
+        InventoryComponent = Owner->FindComponentByClass<USHIInventoryComponent>();
+        EquipmentComponent = Owner->FindComponentByClass<USHIEquipmentComponent>();
+        HotbarComponent = Owner->FindComponentByClass<USHIHotbarComponent>();
+    }
+
+    // Per slot events fire on the server and on clients, so both sides keep their own index
+    if (InventoryComponent)
+    {
+        InventoryComponent->OnInventoryChanged.AddDynamic(this, &USHIItemOwnershipComponent::HandleInventorySlotChanged);
+        // The server seeds from its full storage, a paged client only knows the viewed page
+        for (const FSHIInventorySlot& Slot : InventoryComponent->GetStoredSlots())
+        {
+            ReportSlot(ESHIItemContainer::Envanter, Slot.SlotIndex, Slot.ItemData, Slot.Quantity);
+        }
+    }
+
+    if (EquipmentComponent)
+    {
+        EquipmentComponent->OnEquipmentChanged.AddDynamic(this, &USHIItemOwnershipComponent::HandleEquipmentChanged);
+        const FSHIEquipmentState& EquipmentState = EquipmentComponent->GetEquipmentState();
+        for (int32 i = 1; i < FSHIEquipmentState::NumSlots; i++)
+        {
+            ReportSlot(ESHIItemContainer::Ekipman, i, EquipmentState.Slots[i].ItemData, EquipmentState.Slots[i].Quantity);
+        }
+    }
+
+    if (HotbarComponent)
+    {
+        HotbarComponent->OnHotbarSlotChanged.AddDynamic(this, &USHIItemOwnershipComponent::HandleHotbarSlotChanged);
+        const TArray<FConsumableSlotData>& HotbarSlots = HotbarComponent->GetAllSlots();
+        for (int32 i = 0; i < HotbarSlots.Num(); i++)
+        {
+            ReportSlot(ESHIItemContainer::HizliBar, i, HotbarSlots[i].ItemData, HotbarSlots[i].Quantity);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("SHI Item ownership index ready: %d item types"), OwnedItems.Num());
+}
+
+void USHIItemOwnershipComponent::HandleInventorySlotChanged(int32 SlotIndex, const FSHIInventorySlot& NewSlot)
+{
+    ReportSlot(ESHIItemContainer::Envanter, SlotIndex, NewSlot.ItemData, NewSlot.Quantity);
+}
+
+void USHIItemOwnershipComponent::HandleEquipmentChanged(ESHIEquipmentSlot SlotType, USHIItemData* NewItem, USHIItemData* OldItem)
+{
+    const int32 Quantity = (NewItem && EquipmentComponent) ? EquipmentComponent->GetEquippedItem(SlotType).Quantity : 0;
+    ReportSlot(ESHIItemContainer::Ekipman, (int32)SlotType, NewItem, Quantity);
+}
+
+void USHIItemOwnershipComponent::HandleHotbarSlotChanged(int32 SlotIndex, const FConsumableSlotData& SlotData)
+{
+    ReportSlot(ESHIItemContainer::HizliBar, SlotIndex - USHIHotbarComponent::FirstSlotKey, SlotData.ItemData, SlotData.Quantity);
+}
+
+void USHIItemOwnershipComponent::ReportSlot(ESHIItemContainer Container, int32 SlotIndex, USHIItemData* ItemData, int32 Quantity)
+{
+    if (Container >= ESHIItemContainer::Max || SlotIndex < 0)
+    {
+        return;
+    }
+
+    TArray<FSHIIndexedSlot>& Shadow = ContainerShadows[(uint8)Container];
+    if (SlotIndex >= Shadow.Num())
+    {
+        Shadow.SetNum(SlotIndex + 1);
+    }
+
+    USHIItemData* NewItem = Quantity > 0 ? ItemData : nullptr;
+    const int32 NewQuantity = NewItem ? Quantity : 0;
+
+    FSHIIndexedSlot& Known = Shadow[SlotIndex];
+    if (Known.ItemData == NewItem && Known.Quantity == NewQuantity)
+    {
+        return;
+    }
+
+    USHIItemData* OldItem = Known.ItemData;
+    if (OldItem)
+    {
+        RemoveLocation(OldItem, Container, SlotIndex, Known.Quantity);
+    }
+    if (NewItem)
+    {
+        AddLocation(NewItem, Container, SlotIndex, NewQuantity);
+    }
+
+    Known.ItemData = NewItem;
+    Known.Quantity = NewQuantity;
+
+    if (OldItem && OldItem != NewItem)
+    {
+        OnOwnedItemCountChanged.Broadcast(OldItem, GetOwnedCount(OldItem));
+    }
+    if (NewItem)
+    {
+        OnOwnedItemCountChanged.Broadcast(NewItem, GetOwnedCount(NewItem));
+    }
+}
+
+void USHIItemOwnershipComponent::RemoveLocation(USHIItemData* ItemData, ESHIItemContainer Container, int32 SlotIndex, int32 Quantity)
+{
+    FSHIOwnedItem* Owned = OwnedItems.Find(ItemData);
+    if (!Owned)
+    {
+        return;
+    }
+
+    Owned->TotalQuantity -= Quantity;
+    Owned->ContainerQuantity[(uint8)Container] -= Quantity;
+    Owned->Locations.RemoveAllSwap([Container, SlotIndex](const FSHIItemLocation& Location)
+    {
+        return Location.Container == Container && Location.SlotIndex == SlotIndex;
+    });
+
+    if (Owned->Locations.Num() == 0)
+    {
+        OwnedItems.Remove(ItemData);
+    }
+}
+
+void USHIItemOwnershipComponent::AddLocation(USHIItemData* ItemData, ESHIItemContainer Container, int32 SlotIndex, int32 Quantity)
+{
+    FSHIOwnedItem& Owned = OwnedItems.FindOrAdd(ItemData);
+    Owned.TotalQuantity += Quantity;
+    Owned.ContainerQuantity[(uint8)Container] += Quantity;
+
+    FSHIItemLocation& Location = Owned.Locations.AddDefaulted_GetRef();
+    Location.Container = Container;
+    Location.SlotIndex = SlotIndex;
+    Location.Quantity = Quantity;
+}
+
+int32 USHIItemOwnershipComponent::GetOwnedCount(USHIItemData* ItemData) const
+{
+    const FSHIOwnedItem* Owned = OwnedItems.Find(ItemData);
+    return Owned ? Owned->TotalQuantity : 0;
+}
+
+int32 USHIItemOwnershipComponent::GetOwnedCountIn(USHIItemData* ItemData, ESHIItemContainer Container) const
+{
+    if (Container >= ESHIItemContainer::Max)
+    {
+        return 0;
+    }
+
+    const FSHIOwnedItem* Owned = OwnedItems.Find(ItemData);
+    return Owned ? Owned->ContainerQuantity[(uint8)Container] : 0;
+}
+
+TArray<FSHIItemLocation> USHIItemOwnershipComponent::GetItemLocations(USHIItemData* ItemData) const
+{
+    TArray<FSHIItemLocation> Result;
+    if (const FSHIOwnedItem* Owned = OwnedItems.Find(ItemData))
+    {
+        Result.Append(Owned->Locations.GetData(), Owned->Locations.Num());
+    }
+    return Result;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Data/SHIItemData.h"
+#include "Components/SHIInventoryComponent.h"
+#include "Components/SHIHotbarComponent.h"
+#include "SHIItemOwnershipComponent.generated.h"
+
+class USHIEquipmentComponent;
+
+// Containers tracked by the ownership index
+UENUM(BlueprintType)
+enum class ESHIItemContainer : uint8
+{
+    Envanter    UMETA(DisplayName = "Envanter"),      // Inventory
+    Ekipman     UMETA(DisplayName = "Ekipman"),       // Equipment (slot = ESHIEquipmentSlot)
+    HizliBar    UMETA(DisplayName = "Hızlı Bar"),     // Consumables hotbar
+
+    Max UMETA(Hidden)
+};
+
+// Where a stack of an item sits
+USTRUCT(BlueprintType)
+struct FSHIItemLocation
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Item Ownership")
+    ESHIItemContainer Container = ESHIItemContainer::Envanter;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Item Ownership")
+    int32 SlotIndex = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Item Ownership")
+    int32 Quantity = 0;
+};
+
+// Everything the character owns of one item
+struct FSHIOwnedItem
+{
+    int32 TotalQuantity = 0;
+    int32 ContainerQuantity[(uint8)ESHIItemContainer::Max] = {};
+    TArray<FSHIItemLocation, TInlineAllocator<4>> Locations;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOwnedItemCountChanged, USHIItemData*, Item, int32, TotalQuantity);
+
+// Per character index over inventory, equipment and hotbar - O(1) "how many do I own" for crafting and quests
+UCLASS(ClassGroup=(SHI), meta=(BlueprintSpawnableComponent))
+class STILLHEREISTANBUL_API USHIItemOwnershipComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    USHIItemOwnershipComponent();
+
+    // Query functions
+    UFUNCTION(BlueprintPure, Category = "Item Ownership")
+    int32 GetOwnedCount(USHIItemData* ItemData) const;
+
+    UFUNCTION(BlueprintPure, Category = "Item Ownership")
+    int32 GetOwnedCountIn(USHIItemData* ItemData, ESHIItemContainer Container) const;
+
+    UFUNCTION(BlueprintPure, Category = "Item Ownership")
+    bool HasItem(USHIItemData* ItemData, int32 Quantity = 1) const { return GetOwnedCount(ItemData) >= Quantity; }
+
+    UFUNCTION(BlueprintPure, Category = "Item Ownership")
+    TArray<FSHIItemLocation> GetItemLocations(USHIItemData* ItemData) const;
+
+    // Events
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnOwnedItemCountChanged OnOwnedItemCountChanged;
+
+protected:
+    virtual void BeginPlay() override;
+
+    UFUNCTION()
+    void HandleInventorySlotChanged(int32 SlotIndex, const FSHIInventorySlot& NewSlot);
+
+    UFUNCTION()
+    void HandleEquipmentChanged(ESHIEquipmentSlot SlotType, USHIItemData* NewItem, USHIItemData* OldItem);
+
+    UFUNCTION()
+    void HandleHotbarSlotChanged(int32 SlotIndex, const FConsumableSlotData& SlotData);
+
+    // Every container reports its slot changes here, only from its own component events
+    void ReportSlot(ESHIItemContainer Container, int32 SlotIndex, USHIItemData* ItemData, int32 Quantity);
+
+    void RemoveLocation(USHIItemData* ItemData, ESHIItemContainer Container, int32 SlotIndex, int32 Quantity);
+    void AddLocation(USHIItemData* ItemData, ESHIItemContainer Container, int32 SlotIndex, int32 Quantity);
+
+    UPROPERTY()
+    USHIInventoryComponent* InventoryComponent;
+
+    UPROPERTY()
+    USHIEquipmentComponent* EquipmentComponent;
+
+    UPROPERTY()
+    USHIHotbarComponent* HotbarComponent;
+
+    TMap<USHIItemData*, FSHIOwnedItem> OwnedItems;
+
+    // Last known contents of every container slot, used to diff each report
+    TArray<FSHIIndexedSlot> ContainerShadows[(uint8)ESHIItemContainer::Max];
+};
\ No newline at end of file
@@ -0,0 +1,242 @@
+﻿#include "SHIItemRegistry.h"
+#include "Data/SHIItemData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/Crc.h"
+#include "UObject/CoreNet.h"
+
+USHIItemRegistry* USHIItemRegistry::Get()
+{
+    return GEngine ? GEngine->GetEngineSubsystem<USHIItemRegistry>() : nullptr;
+}
+
+void USHIItemRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Rebuild once the asset manager has seen every item
+    if (UAssetManager::IsInitialized())
+    {
+        UAssetManager::Get().CallOrRegister_OnCompletedInitialScan(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &USHIItemRegistry::BuildRegistry));
+    }
+}
+
+void USHIItemRegistry::BuildRegistry()
+{
+    if (!UAssetManager::IsInitialized())
+    {
+        return;
+    }
+
+    TArray<FPrimaryAssetId> AssetIds;
+    UAssetManager::Get().GetPrimaryAssetIdList(FPrimaryAssetType("SHIItem"), AssetIds);
+
+    // Sorted by name - the order the assets were scanned in is not stable across machines
+    AssetIds.Sort([](const FPrimaryAssetId& A, const FPrimaryAssetId& B)
+    {
+        return A.PrimaryAssetName.LexicalLess(B.PrimaryAssetName);
+    });
+
+    if (AssetIds.Num() >= MAX_uint16)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SHI Item registry: %d items do not fit in 16 bit ids"), AssetIds.Num());
+        AssetIds.SetNum(MAX_uint16 - 1);
+    }
+
+    ItemAssetIds = MoveTemp(AssetIds);
+    ItemIdsByAsset.Reset();
+    ItemIdsByAsset.Reserve(ItemAssetIds.Num());
+    const int32 NumItems = ItemAssetIds.Num();
+    ContentHash = FCrc::MemCrc32(&NumItems, sizeof(NumItems));
+    for (int32 i = 0; i < ItemAssetIds.Num(); i++)
+    {
+        ItemIdsByAsset.Add(ItemAssetIds[i], static_cast<uint16>(i + 1));
+        ContentHash = FCrc::StrCrc32(*ItemAssetIds[i].ToString(), ContentHash);
+    }
+
+    ResolvedItems.Reset();
+    ResolvedItems.SetNum(ItemAssetIds.Num());
+
+    // A build during the initial scan is only provisional, the scan callback rebuilds it
+    bRegistryBuilt = UAssetManager::Get().HasInitialScanCompleted();
+
+    UE_LOG(LogTemp, Log, TEXT("SHI Item registry built with %d items (hash %08x)"), ItemAssetIds.Num(), ContentHash);
+
+    // Load every item up front, in the background - NetSerialize must never wait on the disk
+    if (bRegistryBuilt && !PreloadHandle.IsValid() && !bItemsPreloaded)
+    {
+        PreloadHandle = UAssetManager::Get().LoadPrimaryAssets(ItemAssetIds, TArray<FName>(),
+            FStreamableDelegate::CreateUObject(this, &USHIItemRegistry::OnItemsPreloaded));
+        if (!PreloadHandle.IsValid() || PreloadHandle->HasLoadCompleted())
+        {
+            OnItemsPreloaded();
+        }
+    }
+}
+
+void USHIItemRegistry::OnItemsPreloaded()
+{
+    if (bItemsPreloaded)
+    {
+        return;
+    }
+    bItemsPreloaded = true;
+
+    UE_LOG(LogTemp, Log, TEXT("SHI Item registry preloaded %d items"), ItemAssetIds.Num());
+
+    ItemsPreloadedDelegate.Broadcast();
+    ItemsPreloadedDelegate.Clear();
+}
+
+void USHIItemRegistry::CallOrRegister_OnItemsPreloaded(FSimpleDelegate&& Delegate)
+{
+    if (bItemsPreloaded)
+    {
+        Delegate.ExecuteIfBound();
+        return;
+    }
+
+    ItemsPreloadedDelegate.Add(MoveTemp(Delegate));
+}
+
+uint32 USHIItemRegistry::GetContentHash()
+{
+    if (!bRegistryBuilt)
+    {
+        BuildRegistry();
+    }
+    return ContentHash;
+}
+
+void USHIItemRegistry::EnableItemIds(UPackageMap* Map)
+{
+    if (!Map)
+    {
+        return;
+    }
+
+    // Drop the maps of closed connections
+    for (auto It = ItemIdMaps.CreateIterator(); It; ++It)
+    {
+        if (!It->IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    ItemIdMaps.Add(TWeakObjectPtr<UPackageMap>(Map));
+}
+
+bool USHIItemRegistry::AreItemIdsEnabled(UPackageMap* Map) const
+{
+    return Map && ItemIdMaps.Contains(TWeakObjectPtr<UPackageMap>(Map));
+}
+
+uint16 USHIItemRegistry::GetItemId(const USHIItemData* ItemData)
+{
+    if (!ItemData)
+    {
+        return InvalidItemId;
+    }
+
+    if (!bRegistryBuilt)
+    {
+        BuildRegistry();
+    }
+
+    const uint16* ItemId = ItemIdsByAsset.Find(ItemData->GetPrimaryAssetId());
+    if (!ItemId)
+    {
+        return InvalidItemId;
+    }
+
+    // Remember the pointer so resolving the id on this machine is a plain array read
+    TWeakObjectPtr<USHIItemData>& Resolved = ResolvedItems[*ItemId - 1];
+    if (!Resolved.IsValid())
+    {
+        Resolved = const_cast<USHIItemData*>(ItemData);
+    }
+    return *ItemId;
+}
+
+USHIItemData* USHIItemRegistry::ResolveItem(uint16 ItemId)
+{
+    if (!bRegistryBuilt)
+    {
+        BuildRegistry();
+    }
+
+    if (ItemId == InvalidItemId || ItemId > ItemAssetIds.Num())
+    {
+        return nullptr;
+    }
+
+    TWeakObjectPtr<USHIItemData>& Resolved = ResolvedItems[ItemId - 1];
+    if (USHIItemData* ItemData = Resolved.Get())
+    {
+        return ItemData;
+    }
+
+    // Connections only switch to ids after the preload finished, so the item is already in memory
+    const FPrimaryAssetId& AssetId = ItemAssetIds[ItemId - 1];
+    USHIItemData* ItemData = Cast<USHIItemData>(UAssetManager::Get().GetPrimaryAssetObject(AssetId));
+    if (!ItemData)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SHI Item registry: item id %d (%s) is not loaded"), ItemId, *AssetId.ToString());
+        return nullptr;
+    }
+
+    Resolved = ItemData;
+    return ItemData;
+}
+
+int32 USHIItemRegistry::GetNumItems()
+{
+    if (!bRegistryBuilt)
+    {
+        BuildRegistry();
+    }
+    return ItemAssetIds.Num();
+}
+
+void USHIItemRegistry::NetSerializeItem(FArchive& Ar, UPackageMap* Map, USHIItemData*& ItemData)
+{
+    // 0 = empty, 1 = registry id, 2 = object reference (item is not registered, or the connection has not verified the hash)
+    USHIItemRegistry* Registry = Get();
+    uint8 Mode = 0;
+    uint16 ItemId = InvalidItemId;
+
+    if (Ar.IsSaving() && ItemData)
+    {
+        ItemId = Registry && Registry->AreItemIdsEnabled(Map) ? Registry->GetItemId(ItemData) : InvalidItemId;
+        Mode = ItemId != InvalidItemId ? 1 : 2;
+    }
+
+    Ar.SerializeBits(&Mode, 2);
+
+    if (Mode == 1)
+    {
+        Ar << ItemId;
+        if (Ar.IsLoading())
+        {
+            ItemData = Registry ? Registry->ResolveItem(ItemId) : nullptr;
+        }
+    }
+    else if (Mode == 2)
+    {
+        UObject* Object = ItemData;
+        if (Map)
+        {
+            Map->SerializeObject(Ar, USHIItemData::StaticClass(), Object);
+        }
+        if (Ar.IsLoading())
+        {
+            ItemData = Cast<USHIItemData>(Object);
+        }
+    }
+    else if (Ar.IsLoading())
+    {
+        ItemData = nullptr;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "SHIItemRegistry.generated.h"
+
+class USHIItemData;
+class UPackageMap;
+struct FStreamableHandle;
+
+// Maps every "SHIItem" primary asset to a compact numeric id.
+// Ids are assigned from the sorted asset list, so server and clients built from the same content agree on them.
+// A connection only uses ids once both ends reported the same content hash, until then items go as object references.
+UCLASS()
+class STILLHEREISTANBUL_API USHIItemRegistry : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr uint16 InvalidItemId = 0;
+
+    static USHIItemRegistry* Get();
+
+    // 0 if the item is not a registered primary asset
+    uint16 GetItemId(const USHIItemData* ItemData);
+
+    // Items are preloaded when the registry is built, nullptr if the id is unknown or the item is not loaded yet
+    USHIItemData* ResolveItem(uint16 ItemId);
+
+    int32 GetNumItems();
+
+    // Hash of the id table - equal hashes mean equal ids on both machines
+    uint32 GetContentHash();
+
+    // Runs the delegate once every item is in memory (right away if it already is)
+    void CallOrRegister_OnItemsPreloaded(FSimpleDelegate&& Delegate);
+    bool AreItemsPreloaded() const { return bItemsPreloaded; }
+
+    // Called on both ends of a connection once the hashes matched
+    void EnableItemIds(UPackageMap* Map);
+    bool AreItemIdsEnabled(UPackageMap* Map) const;
+
+    // Writes / reads an item reference - registered items as a 16 bit id, anything else as an object reference
+    static void NetSerializeItem(FArchive& Ar, UPackageMap* Map, USHIItemData*& ItemData);
+
+protected:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    // Built lazily, the asset manager may still be scanning when engine subsystems start
+    void BuildRegistry();
+    void OnItemsPreloaded();
+
+    bool bRegistryBuilt = false;
+    bool bItemsPreloaded = false;
+    uint32 ContentHash = 0;
+
+    // Keeps every item loaded so resolving an id never has to load from disk
+    TSharedPtr<FStreamableHandle> PreloadHandle;
+    FSimpleMulticastDelegate ItemsPreloadedDelegate;
+
+    // Package maps of the connections that verified the content hash
+    TSet<TWeakObjectPtr<UPackageMap>> ItemIdMaps;
+
+    // Index = id - 1
+    TArray<FPrimaryAssetId> ItemAssetIds;
+    TMap<FPrimaryAssetId, uint16> ItemIdsByAsset;
+    TArray<TWeakObjectPtr<USHIItemData>> ResolvedItems;
+};
\ No newline at end of file
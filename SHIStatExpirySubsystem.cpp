@@ -0,0 +1,82 @@
+﻿#include "SHIStatExpirySubsystem.h"
+#include "Components/SHIStatsComponent.h"
+#include "Engine/World.h"
+
+namespace
+{
+    struct FSHIExpiresSooner
+    {
+        bool operator()(const FSHIStatExpiryEntry& A, const FSHIStatExpiryEntry& B) const
+        {
+            return A.ExpireTime < B.ExpireTime;
+        }
+    };
+}
+
+void USHIStatExpirySubsystem::RegisterExpiry(USHIStatsComponent* Component, int32 HandleId, float Duration)
+{
+    UWorld* World = GetWorld();
+    if (!Component || !World)
+    {
+        return;
+    }
+
+    FSHIStatExpiryEntry Entry;
+    Entry.ExpireTime = World->GetTimeSeconds() + FMath::Max(Duration, 0.0f);
+    Entry.Component = Component;
+    Entry.HandleId = HandleId;
+    ExpiryHeap.HeapPush(Entry, FSHIExpiresSooner());
+}
+
+void USHIStatExpirySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // Pop everything that is due
+    const double Now = World->GetTimeSeconds();
+    ExpiredBatch.Reset();
+    while (ExpiryHeap.Num() > 0 && ExpiryHeap.HeapTop().ExpireTime <= Now)
+    {
+        FSHIStatExpiryEntry& Expired = ExpiredBatch.AddDefaulted_GetRef();
+        ExpiryHeap.HeapPop(Expired, FSHIExpiresSooner(), EAllowShrinking::No);
+    }
+
+    if (ExpiredBatch.Num() == 0)
+    {
+        return;
+    }
+
+    // Group by component so each one recalculates once for everything that expired on it
+    ExpiredBatch.Sort([](const FSHIStatExpiryEntry& A, const FSHIStatExpiryEntry& B)
+    {
+        return A.Component.Get() < B.Component.Get();
+    });
+
+    for (int32 i = 0; i < ExpiredBatch.Num(); )
+    {
+        USHIStatsComponent* Component = ExpiredBatch[i].Component.Get();
+        HandleBatch.Reset();
+        for (; i < ExpiredBatch.Num() && ExpiredBatch[i].Component.Get() == Component; i++)
+        {
+            HandleBatch.Add(ExpiredBatch[i].HandleId);
+        }
+
+        if (Component)
+        {
+            Component->ExpireModifiers(HandleBatch);
+        }
+    }
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("SHI Stat expiry: %d modifiers expired, %d pending"), ExpiredBatch.Num(), ExpiryHeap.Num());
+}
+
+TStatId USHIStatExpirySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USHIStatExpirySubsystem, STATGROUP_Tickables);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SHIStatExpirySubsystem.generated.h"
+
+class USHIStatsComponent;
+
+// One registered modifier expiry
+struct FSHIStatExpiryEntry
+{
+    double ExpireTime = 0.0;
+    TWeakObjectPtr<USHIStatsComponent> Component;
+    int32 HandleId = 0;
+};
+
+// Expires temporary stat modifiers for the whole world from one min-heap, in a batch per tick.
+// Stats components only register expiries - no timer or delegate per buff.
+UCLASS()
+class STILLHEREISTANBUL_API USHIStatExpirySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Modifiers removed early are left in the heap, the component ignores handles it no longer has
+    void RegisterExpiry(USHIStatsComponent* Component, int32 HandleId, float Duration);
+
+    int32 GetNumPendingExpiries() const { return ExpiryHeap.Num(); }
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override { return ExpiryHeap.Num() > 0; }
+    virtual TStatId GetStatId() const override;
+
+protected:
+    // Min-heap on ExpireTime
+    TArray<FSHIStatExpiryEntry> ExpiryHeap;
+
+    // Reused every tick
+    TArray<FSHIStatExpiryEntry> ExpiredBatch;
+    TArray<int32> HandleBatch;
+};
\ No newline at end of file
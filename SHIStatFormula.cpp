@@ -0,0 +1,321 @@
+﻿#include "SHIStatFormula.h"
+
+namespace
+{
+    // '~' is unary minus
+    int32 GetPrecedence(TCHAR Op)
+    {
+        switch (Op)
+        {
+            case TEXT('~'): return 3;
+            case TEXT('*'):
+            case TEXT('/'): return 2;
+            case TEXT('+'):
+            case TEXT('-'): return 1;
+            default: return 0;
+        }
+    }
+}
+
+float FSHICompiledFormula::Evaluate(const float* StatValues) const
+{
+    float Stack[MaxStackDepth];
+    int32 Top = 0;
+
+    for (const FSHIFormulaInstruction& Instruction : Code)
+    {
+        switch (Instruction.Op)
+        {
+            case ESHIFormulaOp::PushConst:
+                Stack[Top++] = Instruction.Constant;
+                break;
+
+            case ESHIFormulaOp::PushStat:
+                Stack[Top++] = StatValues[(uint8)Instruction.Stat];
+                break;
+
+            case ESHIFormulaOp::Neg:
+                Stack[Top - 1] = -Stack[Top - 1];
+                break;
+
+            default:
+            {
+                const float Right = Stack[--Top];
+                float& Left = Stack[Top - 1];
+                switch (Instruction.Op)
+                {
+                    case ESHIFormulaOp::Add: Left += Right; break;
+                    case ESHIFormulaOp::Sub: Left -= Right; break;
+                    case ESHIFormulaOp::Mul: Left *= Right; break;
+                    case ESHIFormulaOp::Div: Left = Right != 0.0f ? Left / Right : 0.0f; break;
+                    default: break;
+                }
+                break;
+            }
+        }
+    }
+
+    return Top == 1 ? Stack[0] : 0.0f;
+}
+
+void FSHICompiledFormula::EvaluateBatch(const float* const* StatColumns, int32 Count, float* OutValues) const
+{
+    check(Count <= BatchWidth);
+
+    float Stack[MaxStackDepth][BatchWidth];
+    int32 Top = 0;
+
+    for (const FSHIFormulaInstruction& Instruction : Code)
+    {
+        switch (Instruction.Op)
+        {
+            case ESHIFormulaOp::PushConst:
+            {
+                float* Slot = Stack[Top++];
+                for (int32 Row = 0; Row < Count; Row++)
+                {
+                    Slot[Row] = Instruction.Constant;
+                }
+                break;
+            }
+
+            case ESHIFormulaOp::PushStat:
+                FMemory::Memcpy(Stack[Top++], StatColumns[(uint8)Instruction.Stat], Count * sizeof(float));
+                break;
+
+            case ESHIFormulaOp::Neg:
+            {
+                float* Slot = Stack[Top - 1];
+                for (int32 Row = 0; Row < Count; Row++)
+                {
+                    Slot[Row] = -Slot[Row];
+                }
+                break;
+            }
+
+            default:
+            {
+                const float* Right = Stack[--Top];
+                float* Left = Stack[Top - 1];
+                switch (Instruction.Op)
+                {
+                    case ESHIFormulaOp::Add: for (int32 Row = 0; Row < Count; Row++) { Left[Row] += Right[Row]; } break;
+                    case ESHIFormulaOp::Sub: for (int32 Row = 0; Row < Count; Row++) { Left[Row] -= Right[Row]; } break;
+                    case ESHIFormulaOp::Mul: for (int32 Row = 0; Row < Count; Row++) { Left[Row] *= Right[Row]; } break;
+                    case ESHIFormulaOp::Div: for (int32 Row = 0; Row < Count; Row++) { Left[Row] = Right[Row] != 0.0f ? Left[Row] / Right[Row] : 0.0f; } break;
+                    default: break;
+                }
+                break;
+            }
+        }
+    }
+
+    if (Top == 1)
+    {
+        FMemory::Memcpy(OutValues, Stack[0], Count * sizeof(float));
+    }
+    else
+    {
+        FMemory::Memzero(OutValues, Count * sizeof(float));
+    }
+}
+
+bool FSHICompiledFormula::Compile(const FString& Expression, FSHICompiledFormula& OutFormula, FString& OutError)
+{
+    OutFormula = FSHICompiledFormula();
+
+    // Shunting-yard: operands go straight to the output, operators wait on this stack
+    TArray<TCHAR, TInlineAllocator<MaxStackDepth>> OpStack;
+    int32 Depth = 0;
+    bool bExpectOperand = true;
+
+    auto Push = [&OutFormula, &Depth, &OutError](const FSHIFormulaInstruction& Instruction) -> bool
+    {
+        if (++Depth > MaxStackDepth)
+        {
+            OutError = TEXT("formula too deep");
+            return false;
+        }
+        OutFormula.Code.Add(Instruction);
+        return true;
+    };
+
+    auto EmitOp = [&OutFormula, &Depth, &OutError](TCHAR Op) -> bool
+    {
+        FSHIFormulaInstruction Instruction;
+        switch (Op)
+        {
+            case TEXT('~'): Instruction.Op = ESHIFormulaOp::Neg; break;
+            case TEXT('+'): Instruction.Op = ESHIFormulaOp::Add; break;
+            case TEXT('-'): Instruction.Op = ESHIFormulaOp::Sub; break;
+            case TEXT('*'): Instruction.Op = ESHIFormulaOp::Mul; break;
+            case TEXT('/'): Instruction.Op = ESHIFormulaOp::Div; break;
+            default:
+                OutError = TEXT("unmatched '('");
+                return false;
+        }
+
+        const int32 Operands = Op == TEXT('~') ? 1 : 2;
+        if (Depth < Operands)
+        {
+            OutError = FString::Printf(TEXT("missing operand for '%c'"), Op);
+            return false;
+        }
+        Depth -= Operands - 1;
+        OutFormula.Code.Add(Instruction);
+        return true;
+    };
+
+    const int32 Length = Expression.Len();
+    for (int32 i = 0; i < Length; )
+    {
+        const TCHAR Char = Expression[i];
+
+        if (FChar::IsWhitespace(Char))
+        {
+            i++;
+        }
+        else if (FChar::IsDigit(Char) || Char == TEXT('.'))
+        {
+            const int32 Start = i;
+            while (i < Length && (FChar::IsDigit(Expression[i]) || Expression[i] == TEXT('.')))
+            {
+                i++;
+            }
+
+            if (!bExpectOperand)
+            {
+                OutError = FString::Printf(TEXT("unexpected number at %d"), Start);
+                return false;
+            }
+
+            FSHIFormulaInstruction Instruction;
+            Instruction.Op = ESHIFormulaOp::PushConst;
+            Instruction.Constant = FCString::Atof(*Expression.Mid(Start, i - Start));
+            if (!Push(Instruction))
+            {
+                return false;
+            }
+            bExpectOperand = false;
+        }
+        else if (FChar::IsAlpha(Char) || Char == TEXT('_'))
+        {
+            const int32 Start = i;
+            while (i < Length && (FChar::IsAlnum(Expression[i]) || Expression[i] == TEXT('_')))
+            {
+                i++;
+            }
+
+            const FString Name = Expression.Mid(Start, i - Start);
+            const ESHIStatType Stat = FSHIStatModifier::ResolveStatName(FName(*Name));
+            if (Stat == ESHIStatType::Max)
+            {
+                OutError = FString::Printf(TEXT("unknown stat '%s'"), *Name);
+                return false;
+            }
+            if (!bExpectOperand)
+            {
+                OutError = FString::Printf(TEXT("unexpected stat '%s'"), *Name);
+                return false;
+            }
+
+            FSHIFormulaInstruction Instruction;
+            Instruction.Op = ESHIFormulaOp::PushStat;
+            Instruction.Stat = Stat;
+            if (!Push(Instruction))
+            {
+                return false;
+            }
+            OutFormula.InputMask |= 1 << (uint8)Stat;
+            bExpectOperand = false;
+        }
+        else if (Char == TEXT('('))
+        {
+            if (!bExpectOperand)
+            {
+                OutError = FString::Printf(TEXT("unexpected '(' at %d"), i);
+                return false;
+            }
+            OpStack.Push(Char);
+            i++;
+        }
+        else if (Char == TEXT(')'))
+        {
+            if (bExpectOperand)
+            {
+                OutError = FString::Printf(TEXT("unexpected ')' at %d"), i);
+                return false;
+            }
+            while (OpStack.Num() > 0 && OpStack.Last() != TEXT('('))
+            {
+                if (!EmitOp(OpStack.Pop()))
+                {
+                    return false;
+                }
+            }
+            if (OpStack.Num() == 0)
+            {
+                OutError = TEXT("unmatched ')'");
+                return false;
+            }
+            OpStack.Pop();
+            i++;
+        }
+        else if (Char == TEXT('+') || Char == TEXT('-') || Char == TEXT('*') || Char == TEXT('/'))
+        {
+            if (bExpectOperand)
+            {
+                // Sign of the next operand
+                if (Char == TEXT('-'))
+                {
+                    OpStack.Push(TEXT('~'));
+                }
+                else if (Char != TEXT('+'))
+                {
+                    OutError = FString::Printf(TEXT("unexpected '%c' at %d"), Char, i);
+                    return false;
+                }
+            }
+            else
+            {
+                while (OpStack.Num() > 0 && OpStack.Last() != TEXT('(') && GetPrecedence(OpStack.Last()) >= GetPrecedence(Char))
+                {
+                    if (!EmitOp(OpStack.Pop()))
+                    {
+                        return false;
+                    }
+                }
+                OpStack.Push(Char);
+                bExpectOperand = true;
+            }
+            i++;
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("unexpected '%c' at %d"), Char, i);
+            return false;
+        }
+    }
+
+    if (bExpectOperand)
+    {
+        OutError = TEXT("incomplete formula");
+        return false;
+    }
+
+    while (OpStack.Num() > 0)
+    {
+        if (!EmitOp(OpStack.Pop()))
+        {
+            return false;
+        }
+    }
+
+    if (Depth != 1)
+    {
+        OutError = TEXT("malformed formula");
+        return false;
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/SHIItemData.h"
+
+// Postfix instruction set of a compiled stat formula
+enum class ESHIFormulaOp : uint8
+{
+    PushConst,
+    PushStat,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Neg
+};
+
+struct FSHIFormulaInstruction
+{
+    ESHIFormulaOp Op = ESHIFormulaOp::PushConst;
+    ESHIStatType Stat = ESHIStatType::Max;
+    float Constant = 0.0f;
+};
+
+// A formula such as "100 + Dayaniklilik * 15" compiled to postfix bytecode.
+// Supports numbers, core stat names, + - * /, unary minus and parentheses.
+struct STILLHEREISTANBUL_API FSHICompiledFormula
+{
+    // Evaluation runs on a fixed stack of this size, deeper formulas are rejected at compile time
+    static constexpr int32 MaxStackDepth = 16;
+
+    // Rows evaluated together by EvaluateBatch
+    static constexpr int32 BatchWidth = 64;
+
+    TArray<FSHIFormulaInstruction> Code;
+
+    // Bit i set = reads ESHIStatType i
+    uint8 InputMask = 0;
+
+    bool IsValid() const { return Code.Num() > 0; }
+
+    // StatValues is indexed by ESHIStatType - no allocation
+    float Evaluate(const float* StatValues) const;
+
+    // Same program over up to BatchWidth rows at once - StatColumns[stat][row], one instruction per pass over the rows
+    void EvaluateBatch(const float* const* StatColumns, int32 Count, float* OutValues) const;
+
+    static bool Compile(const FString& Expression, FSHICompiledFormula& OutFormula, FString& OutError);
+};
\ No newline at end of file
@@ -0,0 +1,226 @@
+﻿#include "SHIStatStoreSubsystem.h"
+#include "Async/ParallelFor.h"
+
+int32 USHIStatStoreSubsystem::AddRow(USHIStatsComponent* Owner, TSharedRef<const FSHIStatRules> Rules)
+{
+    int32 Row;
+    if (FreeRows.Num() > 0)
+    {
+        Row = FreeRows.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Row = RowOwners.Num();
+        for (int32 s = 0; s < NumStats; s++)
+        {
+            InputColumns[s].AddZeroed();
+            FlatColumns[s].AddZeroed();
+            PercentColumns[s].AddZeroed();
+            OverrideColumns[s].AddZeroed();
+            CurrentColumns[s].AddZeroed();
+        }
+        for (int32 d = 0; d < NumDerived; d++)
+        {
+            DerivedColumns[d].AddZeroed();
+        }
+        OverrideMasks.Add(0);
+        RowOwners.AddDefaulted();
+        RowRuleSets.Add(0);
+        RowInUse.Add(false);
+        RowDirty.Add(false);
+    }
+
+    RowOwners[Row] = Owner;
+    RowRuleSets[Row] = static_cast<uint16>(FindOrAddRuleSet(Rules));
+    RowInUse[Row] = true;
+    NumUsedRows++;
+
+    // Start from default stats with no modifiers
+    SetRowInputs(Row, FSHICharacterStats(), FSHIModifierLayers());
+    return Row;
+}
+
+void USHIStatStoreSubsystem::RemoveRow(int32 Row)
+{
+    if (!IsRowValid(Row))
+    {
+        return;
+    }
+
+    if (RowDirty[Row])
+    {
+        RowDirty[Row] = false;
+        DirtyRows.RemoveSingleSwap(Row, EAllowShrinking::No);
+    }
+
+    RowOwners[Row].Reset();
+    RowInUse[Row] = false;
+    FreeRows.Add(Row);
+    NumUsedRows--;
+}
+
+void USHIStatStoreSubsystem::SetRowInputs(int32 Row, const FSHICharacterStats& Inputs, const FSHIModifierLayers& Layers)
+{
+    if (!IsRowValid(Row))
+    {
+        return;
+    }
+
+    for (int32 s = 0; s < NumStats; s++)
+    {
+        InputColumns[s][Row] = Inputs.GetStat(static_cast<ESHIStatType>(s));
+        FlatColumns[s][Row] = Layers.Flat[s];
+        PercentColumns[s][Row] = Layers.Percent[s];
+        OverrideColumns[s][Row] = Layers.Override[s];
+    }
+    OverrideMasks[Row] = Layers.OverrideMask;
+
+    MarkRowDirty(Row);
+}
+
+FSHICharacterStats USHIStatStoreSubsystem::GetRowStats(int32 Row) const
+{
+    FSHICharacterStats Stats;
+    if (IsRowValid(Row))
+    {
+        for (int32 s = 0; s < NumStats; s++)
+        {
+            Stats.SetStat(static_cast<ESHIStatType>(s), CurrentColumns[s][Row]);
+        }
+    }
+    return Stats;
+}
+
+float USHIStatStoreSubsystem::GetRowDerivedStat(int32 Row, ESHIDerivedStat Stat) const
+{
+    return IsRowValid(Row) && Stat < ESHIDerivedStat::Max ? DerivedColumns[(uint8)Stat][Row] : 0.0f;
+}
+
+void USHIStatStoreSubsystem::MarkRowDirty(int32 Row)
+{
+    if (!RowDirty[Row])
+    {
+        RowDirty[Row] = true;
+        DirtyRows.Add(Row);
+    }
+}
+
+int32 USHIStatStoreSubsystem::FindOrAddRuleSet(const TSharedRef<const FSHIStatRules>& Rules)
+{
+    // Rules are shared per table pair, so there are only a handful of sets
+    for (int32 i = 0; i < RuleSets.Num(); i++)
+    {
+        if (RuleSets[i] == Rules)
+        {
+            return i;
+        }
+    }
+    return RuleSets.Add(Rules);
+}
+
+void USHIStatStoreSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    FlushDirtyRows();
+}
+
+void USHIStatStoreSubsystem::FlushDirtyRows()
+{
+    if (DirtyRows.Num() == 0)
+    {
+        return;
+    }
+
+    // Group by rule set so each chunk runs a single formula program, rows ascending for locality
+    DirtyRows.Sort([this](int32 A, int32 B)
+    {
+        return RowRuleSets[A] != RowRuleSets[B] ? RowRuleSets[A] < RowRuleSets[B] : A < B;
+    });
+
+    Chunks.Reset();
+    for (int32 i = 0; i < DirtyRows.Num(); )
+    {
+        FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+        Chunk.Start = i;
+        const uint16 RuleSet = RowRuleSets[DirtyRows[i]];
+        while (i < DirtyRows.Num() && i - Chunk.Start < FSHICompiledFormula::BatchWidth && RowRuleSets[DirtyRows[i]] == RuleSet)
+        {
+            i++;
+        }
+        Chunk.Count = i - Chunk.Start;
+    }
+
+    // Chunks write disjoint rows, the columns are not resized while this runs
+    ParallelFor(Chunks.Num(), [this](int32 ChunkIndex)
+    {
+        const FChunk& Chunk = Chunks[ChunkIndex];
+        EvaluateChunk(&DirtyRows[Chunk.Start], Chunk.Count);
+    }, Chunks.Num() <= ParallelChunkThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    TArray<int32> EvaluatedRows = MoveTemp(DirtyRows);
+    DirtyRows.Reset();
+    for (int32 Row : EvaluatedRows)
+    {
+        RowDirty[Row] = false;
+    }
+
+    // Results go back to the components on the game thread
+    for (int32 Row : EvaluatedRows)
+    {
+        if (USHIStatsComponent* Owner = RowOwners[Row].Get())
+        {
+            float Derived[NumDerived];
+            for (int32 d = 0; d < NumDerived; d++)
+            {
+                Derived[d] = DerivedColumns[d][Row];
+            }
+            Owner->ApplyStoreResults(GetRowStats(Row), Derived);
+        }
+    }
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("SHI Stat store: %d rows evaluated in %d chunks (%d rows total)"), EvaluatedRows.Num(), Chunks.Num(), NumUsedRows);
+}
+
+void USHIStatStoreSubsystem::EvaluateChunk(const int32* Rows, int32 Count)
+{
+    const FSHIStatRules& Rules = *RuleSets[RowRuleSets[Rows[0]]];
+
+    // Core stats for the chunk, gathered into contiguous columns
+    float Gathered[NumStats][FSHICompiledFormula::BatchWidth];
+    const float* GatheredColumns[NumStats];
+
+    for (int32 s = 0; s < NumStats; s++)
+    {
+        const float* Input = InputColumns[s].GetData();
+        const float* Flat = FlatColumns[s].GetData();
+        const float* Percent = PercentColumns[s].GetData();
+        const float* Override = OverrideColumns[s].GetData();
+        float* Current = CurrentColumns[s].GetData();
+
+        for (int32 j = 0; j < Count; j++)
+        {
+            const int32 Row = Rows[j];
+            Gathered[s][j] = FSHIModifierLayers::Combine(Input[Row], Flat[Row], Percent[Row], (OverrideMasks[Row] >> s) & 1, Override[Row]);
+            Current[Row] = Gathered[s][j];
+        }
+        GatheredColumns[s] = Gathered[s];
+    }
+
+    float Derived[FSHICompiledFormula::BatchWidth];
+    for (int32 d = 0; d < NumDerived; d++)
+    {
+        Rules.DerivedFormulas[d].EvaluateBatch(GatheredColumns, Count, Derived);
+
+        float* Column = DerivedColumns[d].GetData();
+        for (int32 j = 0; j < Count; j++)
+        {
+            Column[Rows[j]] = Derived[j];
+        }
+    }
+}
+
+TStatId USHIStatStoreSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USHIStatStoreSubsystem, STATGROUP_Tickables);
+}
\ No newline at end of file
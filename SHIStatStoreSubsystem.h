@@ -0,0 +1,80 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SHIStatsComponent.h"
+#include "SHIStatStoreSubsystem.generated.h"
+
+// World-level stat store for large populations. Every row keeps its inputs and results in
+// structure-of-arrays columns; dirty rows are evaluated in one batch per tick, in chunks of
+// FSHICompiledFormula::BatchWidth rows, spread over worker threads when the batch is large.
+// A row either mirrors a USHIStatsComponent or is plain data for crowds without components.
+UCLASS()
+class STILLHEREISTANBUL_API USHIStatStoreSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 NumStats = (int32)ESHIStatType::Max;
+    static constexpr int32 NumDerived = (int32)ESHIDerivedStat::Max;
+
+    // Owner may be null - the row is then only read through GetRowStats / GetRowDerivedStat
+    int32 AddRow(USHIStatsComponent* Owner, TSharedRef<const FSHIStatRules> Rules);
+    void RemoveRow(int32 Row);
+
+    // Inputs = base + equipment, Layers = the folded modifier list
+    void SetRowInputs(int32 Row, const FSHICharacterStats& Inputs, const FSHIModifierLayers& Layers);
+
+    bool IsRowValid(int32 Row) const { return RowInUse.IsValidIndex(Row) && RowInUse[Row]; }
+    FSHICharacterStats GetRowStats(int32 Row) const;
+    float GetRowDerivedStat(int32 Row, ESHIDerivedStat Stat) const;
+    int32 GetNumRows() const { return NumUsedRows; }
+
+    // Evaluates every dirty row now and hands the results to their components
+    void FlushDirtyRows();
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override { return DirtyRows.Num() > 0; }
+    virtual TStatId GetStatId() const override;
+
+protected:
+    int32 FindOrAddRuleSet(const TSharedRef<const FSHIStatRules>& Rules);
+    void MarkRowDirty(int32 Row);
+
+    // Rows must share one rule set, Count <= FSHICompiledFormula::BatchWidth
+    void EvaluateChunk(const int32* Rows, int32 Count);
+
+    // Inputs and folded modifier layers, one column per stat
+    TArray<float> InputColumns[NumStats];
+    TArray<float> FlatColumns[NumStats];
+    TArray<float> PercentColumns[NumStats];
+    TArray<float> OverrideColumns[NumStats];
+    TArray<uint8> OverrideMasks;
+
+    // Results
+    TArray<float> CurrentColumns[NumStats];
+    TArray<float> DerivedColumns[NumDerived];
+
+    // Row bookkeeping
+    TArray<TWeakObjectPtr<USHIStatsComponent>> RowOwners;
+    TArray<uint16> RowRuleSets;
+    TBitArray<> RowInUse;
+    TBitArray<> RowDirty;
+    TArray<int32> FreeRows;
+    TArray<int32> DirtyRows;
+    int32 NumUsedRows = 0;
+
+    // Shared compiled rules, rows refer to them by index
+    TArray<TSharedPtr<const FSHIStatRules>> RuleSets;
+
+    struct FChunk
+    {
+        int32 Start = 0;
+        int32 Count = 0;
+    };
+    TArray<FChunk> Chunks;
+
+    // Batches with more chunks than this go to worker threads
+    static constexpr int32 ParallelChunkThreshold = 4;
+};
\ No newline at end of file
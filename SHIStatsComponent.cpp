@@ -2,35 +2,154 @@
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "UObject/ObjectKey.h"
+#include "GameFramework/GameStateBase.h"
 #include "Data/SHIItemData.h"
+#include "Systems/SHIStatExpirySubsystem.h"
+#include "Systems/SHIStatStoreSubsystem.h"
+
+namespace
+{
+    constexpr int32 NumCoreStats = (int32)ESHIStatType::Max;
+    const FName TemporaryModifierSource(TEXT("Temporary"));
+}
+
+// GetStat / SetStat index the stats as a float array starting at Guc
+static_assert(STRUCT_OFFSET(FSHICharacterStats, Ceviklik) == STRUCT_OFFSET(FSHICharacterStats, Guc) + sizeof(float) * (int32)ESHIStatType::Ceviklik, "FSHICharacterStats layout must match ESHIStatType");
+static_assert(STRUCT_OFFSET(FSHICharacterStats, Zeka) == STRUCT_OFFSET(FSHICharacterStats, Guc) + sizeof(float) * (int32)ESHIStatType::Zeka, "FSHICharacterStats layout must match ESHIStatType");
+static_assert(STRUCT_OFFSET(FSHICharacterStats, Odaklanma) == STRUCT_OFFSET(FSHICharacterStats, Guc) + sizeof(float) * (int32)ESHIStatType::Odaklanma, "FSHICharacterStats layout must match ESHIStatType");
+static_assert(STRUCT_OFFSET(FSHICharacterStats, Dayaniklilik) == STRUCT_OFFSET(FSHICharacterStats, Guc) + sizeof(float) * (int32)ESHIStatType::Dayaniklilik, "FSHICharacterStats layout must match ESHIStatType");
 
 void FSHICharacterStats::ApplyModifiers(const TArray<FSHIStatModifier>& Modifiers)
 {
     for (const FSHIStatModifier& Modifier : Modifiers)
     {
-        if (Modifier.StatName == "Guc")
+        const ESHIStatType Stat = Modifier.GetStatType();
+        if (Stat != ESHIStatType::Max)
         {
-            Guc += Modifier.BonusAmount;
+            SetStat(Stat, GetStat(Stat) + Modifier.BonusAmount);
         }
-        else if (Modifier.StatName == "Ceviklik")
-        {
-            Ceviklik += Modifier.BonusAmount;
-        }
-        else if (Modifier.StatName == "Zeka")
+    }
+}
+
+namespace
+{
+    // Stats as last sent to one connection - quantized steps, or the raw float bits when sent exactly
+    class FSHIStatsDeltaState : public INetDeltaBaseState
+    {
+    public:
+        int32 Values[(uint8)ESHIStatType::Max] = {};
+
+        virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
         {
-            Zeka += Modifier.BonusAmount;
+            const FSHIStatsDeltaState* Other = static_cast<const FSHIStatsDeltaState*>(OtherState);
+            return FMemory::Memcmp(Values, Other->Values, sizeof(Values)) == 0;
         }
-        else if (Modifier.StatName == "Odaklanma")
+    };
+
+    // QuantizeStep <= 0 sends exact floats
+    bool NetDeltaSerializeStats(FSHICharacterStats& Stats, FNetDeltaSerializeInfo& DeltaParms, float QuantizeStep)
+    {
+        const bool bQuantize = QuantizeStep > 0.0f;
+
+        if (DeltaParms.Writer)
         {
-            Odaklanma += Modifier.BonusAmount;
+            const FSHIStatsDeltaState* OldState = static_cast<const FSHIStatsDeltaState*>(DeltaParms.OldState);
+            TSharedPtr<FSHIStatsDeltaState> NewState = MakeShared<FSHIStatsDeltaState>();
+            
+            // No base yet = everything changed
+            uint8 ChangedMask = 0;
+            for (int32 i = 0; i < NumCoreStats; i++)
+            {
+                const float Stat = Stats.GetStat(static_cast<ESHIStatType>(i));
+                if (bQuantize)
+                {
+                    NewState->Values[i] = FMath::RoundToInt(Stat / QuantizeStep);
+                }
+                else
+                {
+                    FMemory::Memcpy(&NewState->Values[i], &Stat, sizeof(float));
+                }
+                if (!OldState || OldState->Values[i] != NewState->Values[i])
+                {
+                    ChangedMask |= 1 << i;
+                }
+            }
+            
+            if (ChangedMask == 0)
+            {
+                return false;
+            }
+            
+            FBitWriter& Writer = *DeltaParms.Writer;
+            Writer.SerializeBits(&ChangedMask, NumCoreStats);
+            for (int32 i = 0; i < NumCoreStats; i++)
+            {
+                if (ChangedMask & (1 << i))
+                {
+                    if (bQuantize)
+                    {
+                        // Zigzag so small negatives stay short
+                        const int32 Value = NewState->Values[i];
+                        uint32 Packed = (uint32)((Value << 1) ^ (Value >> 31));
+                        Writer.SerializeIntPacked(Packed);
+                    }
+                    else
+                    {
+                        float Value = Stats.GetStat(static_cast<ESHIStatType>(i));
+                        Writer << Value;
+                    }
+                }
+            }
+            
+            *DeltaParms.NewState = NewState;
+            return true;
         }
-        else if (Modifier.StatName == "Dayaniklilik")
+        
+        if (DeltaParms.Reader)
         {
-            Dayaniklilik += Modifier.BonusAmount;
+            FBitReader& Reader = *DeltaParms.Reader;
+            
+            uint8 ChangedMask = 0;
+            Reader.SerializeBits(&ChangedMask, NumCoreStats);
+            for (int32 i = 0; i < NumCoreStats; i++)
+            {
+                if (ChangedMask & (1 << i))
+                {
+                    if (bQuantize)
+                    {
+                        uint32 Packed = 0;
+                        Reader.SerializeIntPacked(Packed);
+                        const int32 Value = (int32)(Packed >> 1) ^ -(int32)(Packed & 1);
+                        Stats.SetStat(static_cast<ESHIStatType>(i), Value * QuantizeStep);
+                    }
+                    else
+                    {
+                        float Value = 0.0f;
+                        Reader << Value;
+                        Stats.SetStat(static_cast<ESHIStatType>(i), Value);
+                    }
+                }
+            }
+            
+            return !Reader.IsError();
         }
+        
+        // No object references to map
+        return false;
     }
 }
 
+bool FSHICharacterStats::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+    return NetDeltaSerializeStats(*this, DeltaParms, 0.0f);
+}
+
+bool FSHIQuantizedCharacterStats::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+    return NetDeltaSerializeStats(*this, DeltaParms, NetQuantizeStep);
+}
+
 USHIStatsComponent::USHIStatsComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
@@ -47,18 +166,91 @@ void USHIStatsComponent::BeginPlay()
 {
     Super::BeginPlay();
     
+    // Authority evaluates - clients take the replicated CurrentStats
+    if (bUseSharedStatStore && GetOwner() && GetOwner()->HasAuthority())
+    {
+        if (USHIStatStoreSubsystem* StatStore = GetWorld() ? GetWorld()->GetSubsystem<USHIStatStoreSubsystem>() : nullptr)
+        {
+            StatStoreRow = StatStore->AddRow(this, GetStatRulesRef());
+        }
+    }
+    
     // Initialize current stats
+    MarkStatsDirty();
     RecalculateCurrentStats();
     
+    if (GetOwner() && GetOwner()->HasAuthority())
+    {
+        InitializeResourcePools();
+    }
+    
     UE_LOG(LogTemp, Warning, TEXT("SHI Stats initialized - Güç: %f, Zeka: %f"), 
            GetCurrentGuc(), GetCurrentZeka());
 }
 
+void USHIStatsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (StatStoreRow != INDEX_NONE)
+    {
+        if (USHIStatStoreSubsystem* StatStore = GetWorld() ? GetWorld()->GetSubsystem<USHIStatStoreSubsystem>() : nullptr)
+        {
+            StatStore->RemoveRow(StatStoreRow);
+        }
+        StatStoreRow = INDEX_NONE;
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
 void USHIStatsComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     DOREPLIFETIME(USHIStatsComponent, BaseStats);
-    DOREPLIFETIME(USHIStatsComponent, CurrentStats);
+    DOREPLIFETIME(USHIStatsComponent, ResourcePools);
+    
+    // Which set replicates depends on bDeterministicClientStats, see PreReplication
+    DOREPLIFETIME_CONDITION(USHIStatsComponent, CurrentStats, COND_Custom);
+    DOREPLIFETIME_CONDITION(USHIStatsComponent, EquipmentBonuses, COND_Custom);
+    DOREPLIFETIME_CONDITION(USHIStatsComponent, ReplicatedModifiers, COND_Custom);
+}
+
+void USHIStatsComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+    Super::PreReplication(ChangedPropertyTracker);
+    
+    DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USHIStatsComponent, CurrentStats, !bDeterministicClientStats);
+    DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USHIStatsComponent, EquipmentBonuses, bDeterministicClientStats);
+    DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(USHIStatsComponent, ReplicatedModifiers, bDeterministicClientStats);
+}
+
+bool FSHIStatModifierSpec::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    static_assert((uint8)ESHIStatType::Max <= 8, "Stat no longer fits in 3 bits");
+    
+    uint8 Packed = (uint8)Stat | ((uint8)Op << 3) | ((uint8)Stacking << 5);
+    Ar.SerializeBits(&Packed, 7);
+    
+    Ar << Value;
+    Ar << Source;
+    
+    // Priorities are small and mostly 0 - zigzag so negatives stay short too
+    uint32 PackedPriority = (uint32)((Priority << 1) ^ (Priority >> 31));
+    Ar.SerializeIntPacked(PackedPriority);
+    
+    if (Ar.IsLoading())
+    {
+        Stat = static_cast<ESHIStatType>(Packed & 0x07);
+        Op = static_cast<ESHIModifierOp>((Packed >> 3) & 0x03);
+        Stacking = static_cast<ESHIModifierStacking>((Packed >> 5) & 0x03);
+        Priority = (int32)(PackedPriority >> 1) ^ -(int32)(PackedPriority & 1);
+        
+        // Never trust an out of range stat from the wire, the evaluator indexes with it
+        bOutSuccess = Stat < ESHIStatType::Max;
+        return true;
+    }
+    
+    bOutSuccess = true;
+    return true;
 }
 
 void USHIStatsComponent::Server_ModifyBaseStat_Implementation(FName StatName, float Amount)
@@ -68,12 +260,10 @@ void USHIStatsComponent::Server_ModifyBaseStat_Implementation(FName StatName, fl
     
     SetStatByName(BaseStats, StatName, NewValue);
     
-    // Recalculate current stats
+    // Recalculate current stats - OnStatChanged goes out with the next notification flush
+    MarkStatsDirty();
     RecalculateCurrentStats();
     
-    // Broadcast change
-    OnStatChanged.Broadcast(StatName, OldValue, NewValue);
-    
     UE_LOG(LogTemp, Log, TEXT("Base stat %s modified: %f -> %f"), 
            *StatName.ToString(), OldValue, NewValue);
 }
@@ -87,71 +277,543 @@ void USHIStatsComponent::ApplyEquipmentBonuses(const TArray<FSHIStatModifier>& E
     EquipmentBonuses.ApplyModifiers(EquipmentModifiers);
     
     // Recalculate current stats
+    MarkStatsDirty();
     RecalculateCurrentStats();
     
     UE_LOG(LogTemp, Log, TEXT("Equipment bonuses applied: Güç +%f, Zeka +%f, Çeviklik +%f"), 
            EquipmentBonuses.Guc, EquipmentBonuses.Zeka, EquipmentBonuses.Ceviklik);
 }
 
+void USHIStatsComponent::SetEquipmentBonuses(const FSHIStatVector& Bonuses)
+{
+    // EquipmentBonuses only replicates in deterministic mode, a client copy would just go stale
+    if (!EvaluatesStatsLocally())
+    {
+        return;
+    }
+
+    bool bChanged = false;
+    for (int32 i = 0; i < NumCoreStats; i++)
+    {
+        const ESHIStatType Stat = static_cast<ESHIStatType>(i);
+        if (EquipmentBonuses.GetStat(Stat) != Bonuses[Stat])
+        {
+            EquipmentBonuses.SetStat(Stat, Bonuses[Stat]);
+            bChanged = true;
+        }
+    }
+
+    if (bChanged)
+    {
+        MarkStatsDirty();
+        RecalculateCurrentStats();
+    }
+}
+
 void USHIStatsComponent::ClearEquipmentBonuses()
 {
     EquipmentBonuses = FSHICharacterStats();
+    MarkStatsDirty();
     RecalculateCurrentStats();
     
     UE_LOG(LogTemp, Log, TEXT("Equipment bonuses cleared"));
 }
 
-void USHIStatsComponent::ApplyTemporaryModifier(FName StatName, float Amount, float Duration)
+FSHIModifierHandle USHIStatsComponent::AddModifier(const FSHIStatModifierSpec& Spec)
 {
-    // Remove existing temporary modifier if exists
-    if (TempModifierTimers.Contains(StatName))
+    FSHIModifierHandle Handle;
+    
+    if (Spec.Stat >= ESHIStatType::Max)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Modifier ignored - invalid stat"));
+        return Handle;
+    }
+    
+    // A new modifier from the same source on the same stat takes the old one's place
+    if (Spec.Stacking == ESHIModifierStacking::KaynagiDegistir)
     {
-        GetWorld()->GetTimerManager().ClearTimer(TempModifierTimers[StatName]);
+        for (int32 i = ActiveModifiers.Num() - 1; i >= 0; i--)
+        {
+            const FSHIActiveModifier& Existing = ActiveModifiers[i];
+            if (Existing.Spec.Stat == Spec.Stat && Existing.Spec.Source == Spec.Source && Existing.Spec.Op == Spec.Op)
+            {
+                ActiveModifiers.RemoveAt(i);
+            }
+        }
     }
     
-    TempModifierValues.Add(StatName, Amount);
+    FSHIActiveModifier NewModifier;
+    NewModifier.HandleId = NextModifierHandle++;
+    NewModifier.Spec = Spec;
+    
+    // Insert after every modifier of equal or lower priority, the evaluator relies on this order
+    int32 InsertIndex = ActiveModifiers.Num();
+    while (InsertIndex > 0 && ActiveModifiers[InsertIndex - 1].Spec.Priority > Spec.Priority)
+    {
+        InsertIndex--;
+    }
+    ActiveModifiers.Insert(MoveTemp(NewModifier), InsertIndex);
+    
+    Handle.Id = ActiveModifiers[InsertIndex].HandleId;
+    
+    MarkStatsDirty();
     RecalculateCurrentStats();
     
-    // Set timer to remove modifier
-    FTimerHandle TimerHandle;
-    GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this, StatName]()
+    UE_LOG(LogTemp, Log, TEXT("Modifier %d added: %s %s %f (source %s, priority %d)"), 
+           Handle.Id, *UEnum::GetValueAsString(Spec.Stat), *UEnum::GetValueAsString(Spec.Op), Spec.Value, 
+           *Spec.Source.ToString(), Spec.Priority);
+    
+    return Handle;
+}
+
+bool USHIStatsComponent::RemoveModifier(FSHIModifierHandle Handle)
+{
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+    
+    const int32 Index = ActiveModifiers.IndexOfByPredicate([&Handle](const FSHIActiveModifier& Modifier)
+    {
+        return Modifier.HandleId == Handle.Id;
+    });
+    
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    ActiveModifiers.RemoveAt(Index);
+    
+    MarkStatsDirty();
+    RecalculateCurrentStats();
+    return true;
+}
+
+int32 USHIStatsComponent::RemoveModifiersFromSource(FName Source)
+{
+    int32 RemovedCount = 0;
+    for (int32 i = ActiveModifiers.Num() - 1; i >= 0; i--)
+    {
+        if (ActiveModifiers[i].Spec.Source == Source)
+        {
+            ActiveModifiers.RemoveAt(i);
+            RemovedCount++;
+        }
+    }
+    
+    if (RemovedCount > 0)
     {
-        RemoveTemporaryModifier(StatName);
-    }, Duration, false);
+        MarkStatsDirty();
+        RecalculateCurrentStats();
+    }
+    
+    return RemovedCount;
+}
+
+FSHIModifierHandle USHIStatsComponent::ApplyTemporaryModifier(FName StatName, float Amount, float Duration)
+{
+    FSHIStatModifierSpec Spec;
+    Spec.Stat = FSHIStatModifier::ResolveStatName(StatName);
+    Spec.Op = ESHIModifierOp::Ekle;
+    Spec.Value = Amount;
+    Spec.Source = TemporaryModifierSource;
+    Spec.Stacking = ESHIModifierStacking::Yigilir;
     
-    TempModifierTimers.Add(StatName, TimerHandle);
+    FSHIModifierHandle Handle = AddModifier(Spec);
+    if (!Handle.IsValid())
+    {
+        return Handle;
+    }
+    
+    // The world's expiry subsystem removes it again
+    USHIStatExpirySubsystem* ExpirySubsystem = GetWorld() ? GetWorld()->GetSubsystem<USHIStatExpirySubsystem>() : nullptr;
+    if (ExpirySubsystem)
+    {
+        ExpirySubsystem->RegisterExpiry(this, Handle.Id, Duration);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No stat expiry subsystem - temporary modifier %d will not expire"), Handle.Id);
+    }
     
     UE_LOG(LogTemp, Log, TEXT("Temporary modifier applied: %s +%f for %f seconds"), 
            *StatName.ToString(), Amount, Duration);
+    
+    return Handle;
 }
 
 void USHIStatsComponent::RemoveTemporaryModifier(FName StatName)
 {
-    TempModifierValues.Remove(StatName);
-    TempModifierTimers.Remove(StatName);
-    RecalculateCurrentStats();
+    const ESHIStatType Stat = FSHIStatModifier::ResolveStatName(StatName);
+    int32 RemovedCount = 0;
+    for (int32 i = ActiveModifiers.Num() - 1; i >= 0; i--)
+    {
+        const FSHIActiveModifier& Modifier = ActiveModifiers[i];
+        if (Modifier.Spec.Stat == Stat && Modifier.Spec.Source == TemporaryModifierSource)
+        {
+            ActiveModifiers.RemoveAt(i);
+            RemovedCount++;
+        }
+    }
+    
+    if (RemovedCount > 0)
+    {
+        MarkStatsDirty();
+        RecalculateCurrentStats();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Temporary modifier removed: %s (%d)"), *StatName.ToString(), RemovedCount);
+}
+
+void USHIStatsComponent::ExpireModifiers(TConstArrayView<int32> HandleIds)
+{
+    // Handles already removed by hand are simply not found
+    const int32 RemovedCount = ActiveModifiers.RemoveAll([HandleIds](const FSHIActiveModifier& Modifier)
+    {
+        return HandleIds.Contains(Modifier.HandleId);
+    });
+    
+    if (RemovedCount > 0)
+    {
+        MarkStatsDirty();
+        RecalculateCurrentStats();
+        
+        UE_LOG(LogTemp, Log, TEXT("%d temporary modifiers expired"), RemovedCount);
+    }
+}
+
+double USHIStatsComponent::GetResourceTime() const
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0.0;
+    }
+    
+    const AGameStateBase* GameState = World->GetGameState();
+    return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+float USHIStatsComponent::GetResource(ESHIResourceType Resource) const
+{
+    return Resource < ESHIResourceType::Max ? ResourcePools[(uint8)Resource].GetValue(GetResourceTime()) : 0.0f;
+}
+
+float USHIStatsComponent::GetResourceMax(ESHIResourceType Resource) const
+{
+    return Resource < ESHIResourceType::Max ? ResourcePools[(uint8)Resource].MaxValue : 0.0f;
+}
+
+float USHIStatsComponent::GetResourcePercent(ESHIResourceType Resource) const
+{
+    const float MaxValue = GetResourceMax(Resource);
+    return MaxValue > 0.0f ? GetResource(Resource) / MaxValue : 0.0f;
+}
+
+bool USHIStatsComponent::ApplyConsumable(const USHIItemData* Item)
+{
+    if (!Item || Item->ItemType != ESHIItemType::Tuketim || !GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return false;
+    }
+    
+    ESHIResourceType Resource = ESHIResourceType::Max;
+    if (Item->HasTrait(ESHIItemTraits::SaglikIksiri))
+    {
+        Resource = ESHIResourceType::Saglik;
+    }
+    else if (Item->HasTrait(ESHIItemTraits::EnerjiIksiri))
+    {
+        Resource = ESHIResourceType::Enerji;
+    }
+    
+    // Restores only - draining goes through server gameplay code
+    const float Amount = Item->GetRestoreAmount();
+    if (Resource == ESHIResourceType::Max || Amount <= 0.0f)
+    {
+        return false;
+    }
+    
+    ModifyResource(Resource, Amount);
+    return true;
+}
+
+bool USHIStatsComponent::ConsumeResource(ESHIResourceType Resource, float Amount)
+{
+    if (Resource >= ESHIResourceType::Max || !GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return false;
+    }
+    
+    if (GetResource(Resource) < Amount)
+    {
+        return false;
+    }
+    
+    ModifyResource(Resource, -Amount);
+    return true;
+}
+
+void USHIStatsComponent::ModifyResource(ESHIResourceType Resource, float Amount)
+{
+    if (Resource >= ESHIResourceType::Max || !GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return;
+    }
+    
+    FSHIResourcePool& Pool = ResourcePools[(uint8)Resource];
+    Pool.Rebase(GetResourceTime());
+    Pool.BaseValue = FMath::Clamp(Pool.BaseValue + Amount, 0.0f, Pool.MaxValue);
+    
+    OnResourceChanged.Broadcast(Resource, Pool.BaseValue, Pool.MaxValue);
     
-    UE_LOG(LogTemp, Log, TEXT("Temporary modifier removed: %s"), *StatName.ToString());
+    UE_LOG(LogTemp, Log, TEXT("Resource %s %+.0f -> %.0f/%.0f"), 
+           *UEnum::GetValueAsString(Resource), Amount, Pool.BaseValue, Pool.MaxValue);
+}
+
+void USHIStatsComponent::InitializeResourcePools()
+{
+    const double Now = GetResourceTime();
+    const float RegenRates[] = { SaglikRegenPerSecond, EnerjiRegenPerSecond };
+    static_assert(UE_ARRAY_COUNT(RegenRates) == (int32)ESHIResourceType::Max, "Regen rates must match ESHIResourceType");
+    
+    // Start full
+    for (int32 i = 0; i < (int32)ESHIResourceType::Max; i++)
+    {
+        FSHIResourcePool& Pool = ResourcePools[i];
+        Pool.MaxValue = i == (int32)ESHIResourceType::Saglik ? GetMaxSaglik() : GetMaxEnerji();
+        Pool.BaseValue = Pool.MaxValue;
+        Pool.RegenPerSecond = RegenRates[i];
+        Pool.LastUpdateTime = Now;
+    }
+}
+
+void USHIStatsComponent::SyncResourceMaximums()
+{
+    const double Now = GetResourceTime();
+    for (int32 i = 0; i < (int32)ESHIResourceType::Max; i++)
+    {
+        FSHIResourcePool& Pool = ResourcePools[i];
+        const float NewMax = i == (int32)ESHIResourceType::Saglik ? GetMaxSaglik() : GetMaxEnerji();
+        if (NewMax == Pool.MaxValue)
+        {
+            continue;
+        }
+        
+        // Keep the filled fraction, so gear swaps neither heal nor hurt
+        Pool.Rebase(Now);
+        const float Fraction = Pool.MaxValue > 0.0f ? Pool.BaseValue / Pool.MaxValue : 1.0f;
+        Pool.MaxValue = NewMax;
+        Pool.BaseValue = NewMax * Fraction;
+        
+        OnResourceChanged.Broadcast(static_cast<ESHIResourceType>(i), Pool.BaseValue, Pool.MaxValue);
+    }
+}
+
+void USHIStatsComponent::OnRep_ResourcePools()
+{
+    const double Now = GetResourceTime();
+    for (int32 i = 0; i < (int32)ESHIResourceType::Max; i++)
+    {
+        OnResourceChanged.Broadcast(static_cast<ESHIResourceType>(i), ResourcePools[i].GetValue(Now), ResourcePools[i].MaxValue);
+    }
+}
+
+FSHIStatSnapshotRef USHIStatsComponent::CaptureSnapshot() const
+{
+    if (CachedSnapshot.IsValid() && CachedSnapshot->Version == StatsVersion)
+    {
+        return CachedSnapshot.ToSharedRef();
+    }
+    
+    TSharedRef<FSHIStatSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FSHIStatSnapshot, ESPMode::ThreadSafe>();
+    Snapshot->Version = StatsVersion;
+    FMemory::Memcpy(Snapshot->Core, CurrentStats.GetStatData(), sizeof(Snapshot->Core));
+    for (int32 i = 0; i < (int32)ESHIDerivedStat::Max; i++)
+    {
+        Snapshot->Derived[i] = GetDerivedStat(static_cast<ESHIDerivedStat>(i));
+    }
+    
+    CachedSnapshot = Snapshot;
+    return Snapshot;
+}
+
+FSHIStatSnapshotDiff FSHIStatSnapshot::Diff(const FSHIStatSnapshot& From, const FSHIStatSnapshot& To)
+{
+    FSHIStatSnapshotDiff Result;
+    
+    for (int32 i = 0; i < (int32)ESHIStatType::Max; i++)
+    {
+        Result.CoreDelta[i] = To.Core[i] - From.Core[i];
+        if (Result.CoreDelta[i] != 0.0f)
+        {
+            Result.CoreMask |= 1 << i;
+        }
+    }
+    
+    for (int32 i = 0; i < (int32)ESHIDerivedStat::Max; i++)
+    {
+        Result.DerivedDelta[i] = To.Derived[i] - From.Derived[i];
+        if (Result.DerivedDelta[i] != 0.0f)
+        {
+            Result.DerivedMask |= 1 << i;
+        }
+    }
+    
+    return Result;
 }
 
 float USHIStatsComponent::GetMaxSaglik() const
 {
-    return 100.0f + (GetCurrentDayaniklilik() * 15.0f);
+    return GetDerivedStat(ESHIDerivedStat::MaxSaglik);
 }
 
 float USHIStatsComponent::GetMaxEnerji() const
 {
-    return 50.0f + (GetCurrentZeka() * 8.0f) + (GetCurrentOdaklanma() * 5.0f);
+    return GetDerivedStat(ESHIDerivedStat::MaxEnerji);
 }
 
 float USHIStatsComponent::GetHasarBonusu() const
 {
-    return (GetCurrentGuc() * 0.8f) + (GetCurrentCeviklik() * 0.3f);
+    return GetDerivedStat(ESHIDerivedStat::HasarBonusu);
 }
 
 float USHIStatsComponent::GetSavunma() const
 {
-    return (GetCurrentDayaniklilik() * 0.5f) + (GetCurrentCeviklik() * 0.2f);
+    return GetDerivedStat(ESHIDerivedStat::Savunma);
+}
+
+float USHIStatsComponent::GetDerivedStat(ESHIDerivedStat Stat) const
+{
+    if (Stat >= ESHIDerivedStat::Max)
+    {
+        return 0.0f;
+    }
+    
+    const uint8 Bit = 1 << (uint8)Stat;
+    if (DirtyDerivedStats & Bit)
+    {
+        DerivedStatCache[(uint8)Stat] = ComputeDerivedStat(Stat, CurrentStats);
+        DirtyDerivedStats &= ~Bit;
+    }
+    return DerivedStatCache[(uint8)Stat];
+}
+
+const FSHIStatRules& USHIStatsComponent::GetStatRules() const
+{
+    return *GetStatRulesRef();
+}
+
+TSharedRef<const FSHIStatRules> USHIStatsComponent::GetStatRulesRef() const
+{
+    if (!StatRules.IsValid())
+    {
+        StatRules = FSHIStatRules::Get(DerivedStatFormulaTable, StatThresholdTable);
+    }
+    return StatRules.ToSharedRef();
+}
+
+float USHIStatsComponent::ComputeDerivedStat(ESHIDerivedStat Stat, const FSHICharacterStats& Stats) const
+{
+    return Stat < ESHIDerivedStat::Max ? GetStatRules().DerivedFormulas[(uint8)Stat].Evaluate(Stats.GetStatData()) : 0.0f;
+}
+
+uint8 USHIStatsComponent::GetDerivedStatInputs(ESHIDerivedStat Stat) const
+{
+    // Collected by the formula compiler
+    return Stat < ESHIDerivedStat::Max ? GetStatRules().DerivedFormulas[(uint8)Stat].InputMask : 0;
+}
+
+uint8 USHIStatsComponent::GetChangedStatMask(const FSHICharacterStats& A, const FSHICharacterStats& B)
+{
+    uint8 Mask = 0;
+    for (int32 i = 0; i < NumCoreStats; i++)
+    {
+        const ESHIStatType Stat = static_cast<ESHIStatType>(i);
+        if (A.GetStat(Stat) != B.GetStat(Stat))
+        {
+            Mask |= 1 << i;
+        }
+    }
+    return Mask;
+}
+
+void USHIStatsComponent::InvalidateDerivedStats(uint8 ChangedStatMask)
+{
+    if (ChangedStatMask != 0)
+    {
+        bThresholdBonusesDirty = true;
+    }
+    
+    for (int32 i = 0; i < (int32)ESHIDerivedStat::Max; i++)
+    {
+        if (GetDerivedStatInputs(static_cast<ESHIDerivedStat>(i)) & ChangedStatMask)
+        {
+            DirtyDerivedStats |= 1 << i;
+        }
+    }
+}
+
+void USHIStatsComponent::QueueStatNotifications()
+{
+    if (bStatNotifyScheduled)
+    {
+        return;
+    }
+    
+    if (UWorld* World = GetWorld())
+    {
+        bStatNotifyScheduled = true;
+        World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &USHIStatsComponent::FlushStatNotifications));
+    }
+    else
+    {
+        FlushStatNotifications();
+    }
+}
+
+void USHIStatsComponent::FlushStatNotifications()
+{
+    bStatNotifyScheduled = false;
+    
+    // Changes that cancelled out within the frame are not reported
+    const uint8 ChangedMask = GetChangedStatMask(NotifiedStats, CurrentStats);
+    if (ChangedMask == 0)
+    {
+        return;
+    }
+    
+    const FSHICharacterStats OldStats = NotifiedStats;
+    NotifiedStats = CurrentStats;
+    
+    for (int32 i = 0; i < NumCoreStats; i++)
+    {
+        if (ChangedMask & (1 << i))
+        {
+            const ESHIStatType Stat = static_cast<ESHIStatType>(i);
+            OnStatChanged.Broadcast(FSHIStatModifier::GetStatName(Stat), OldStats.GetStat(Stat), CurrentStats.GetStat(Stat));
+        }
+    }
+    
+    static const FName DerivedStatNames[] = { FName(TEXT("MaxSaglik")), FName(TEXT("MaxEnerji")), FName(TEXT("HasarBonusu")), FName(TEXT("Savunma")) };
+    static_assert(UE_ARRAY_COUNT(DerivedStatNames) == (int32)ESHIDerivedStat::Max, "Derived stat names must match ESHIDerivedStat");
+    
+    for (int32 i = 0; i < (int32)ESHIDerivedStat::Max; i++)
+    {
+        const ESHIDerivedStat Stat = static_cast<ESHIDerivedStat>(i);
+        if (GetDerivedStatInputs(Stat) & ChangedMask)
+        {
+            const float OldValue = ComputeDerivedStat(Stat, OldStats);
+            const float NewValue = GetDerivedStat(Stat);
+            if (OldValue != NewValue)
+            {
+                OnStatChanged.Broadcast(DerivedStatNames[i], OldValue, NewValue);
+            }
+        }
+    }
+    
+    OnStatsRecalculated.Broadcast();
 }
 
 int32 USHIStatsComponent::GetStatThresholdLevel(FName StatName) const
@@ -162,84 +824,219 @@ int32 USHIStatsComponent::GetStatThresholdLevel(FName StatName) const
 
 TArray<FText> USHIStatsComponent::GetActiveThresholdBonuses() const
 {
-    TArray<FText> ActiveBonuses;
+    if (bThresholdBonusesDirty)
+    {
+        bThresholdBonusesDirty = false;
+        CachedThresholdBonuses.Reset();
+        
+        for (const FSHIStatRules::FThreshold& Threshold : GetStatRules().Thresholds)
+        {
+            if (CurrentStats.GetStat(Threshold.Stat) >= Threshold.Value)
+            {
+                CachedThresholdBonuses.Add(Threshold.BonusText);
+            }
+        }
+    }
     
-    // Check Güç thresholds
-    int32 GucLevel = GetStatThresholdLevel(FName("Guc"));
-    if (GucLevel >= 1) ActiveBonuses.Add(FText::FromString(TEXT("Güç 50+: Ağır saldırı +15% stamina hasarı")));
-    if (GucLevel >= 2) ActiveBonuses.Add(FText::FromString(TEXT("Güç 100+: Ağır saldırı +20% hasar")));
-    if (GucLevel >= 3) ActiveBonuses.Add(FText::FromString(TEXT("Güç 150+: Hafif saldırı %10 yavaşlatma")));
+    return CachedThresholdBonuses;
+}
+
+void USHIStatsComponent::OnRep_StatInputs()
+{
+    if (!bDeterministicClientStats)
+    {
+        return;
+    }
     
-    // Check other stats...
-    int32 CeviklikLevel = GetStatThresholdLevel(FName("Ceviklik"));
-    if (CeviklikLevel >= 1) ActiveBonuses.Add(FText::FromString(TEXT("Çeviklik 50+: Arkadan saldırı +15% hasar")));
-    if (CeviklikLevel >= 2) ActiveBonuses.Add(FText::FromString(TEXT("Çeviklik 100+: Kaçınma sonrası +20% hasar")));
+    // The replicated list is already in priority order
+    ActiveModifiers.Reset(ReplicatedModifiers.Num());
+    for (const FSHIStatModifierSpec& Spec : ReplicatedModifiers)
+    {
+        if (Spec.Stat < ESHIStatType::Max)
+        {
+            FSHIActiveModifier& Modifier = ActiveModifiers.AddDefaulted_GetRef();
+            Modifier.Spec = Spec;
+        }
+    }
     
-    return ActiveBonuses;
+    MarkStatsDirty();
+    RecalculateCurrentStats();
 }
 
 void USHIStatsComponent::OnRep_CurrentStats()
 {
-    // Broadcast that stats have been updated
-    OnStatsRecalculated.Broadcast();
+    const uint8 ChangedMask = GetChangedStatMask(LastReplicatedStats, CurrentStats);
+    LastReplicatedStats = CurrentStats;
+    if (ChangedMask != 0)
+    {
+        StatsVersion++;
+        InvalidateDerivedStats(ChangedMask);
+        QueueStatNotifications();
+    }
     UE_LOG(LogTemp, VeryVerbose, TEXT("Current stats replicated"));
 }
 
+bool USHIStatsComponent::EvaluatesStatsLocally() const
+{
+    return bDeterministicClientStats || (GetOwner() && GetOwner()->HasAuthority());
+}
+
 void USHIStatsComponent::RecalculateCurrentStats()
 {
-    // Start with base stats
-    CurrentStats = BaseStats;
+    // Default mode clients take CurrentStats from replication, evaluating here would overwrite it
+    if (!EvaluatesStatsLocally())
+    {
+        return;
+    }
+
+    // Nothing changed since the last evaluation - repeated calls are free
+    if (!bStatsDirty)
+    {
+        return;
+    }
+    bStatsDirty = false;
     
-    // Add equipment bonuses
-    CurrentStats = CurrentStats + EquipmentBonuses;
+    // Deterministic mode - clients get the evaluator inputs instead of the result
+    if (bDeterministicClientStats && GetOwner() && GetOwner()->HasAuthority())
+    {
+        ReplicatedModifiers.Reset(ActiveModifiers.Num());
+        for (const FSHIActiveModifier& Modifier : ActiveModifiers)
+        {
+            ReplicatedModifiers.Add(Modifier.Spec);
+        }
+    }
     
-    // Add temporary modifiers
-    for (const auto& TempModifier : TempModifierValues)
+    // The store evaluates this row with everyone else's on its next tick
+    if (StatStoreRow != INDEX_NONE)
     {
-        FName StatName = TempModifier.Key;
-        float Amount = TempModifier.Value;
-        
-        float CurrentValue = GetStatByName(CurrentStats, StatName);
-        SetStatByName(CurrentStats, StatName, FMath::Max(1.0f, CurrentValue + Amount));
+        if (USHIStatStoreSubsystem* StatStore = GetWorld() ? GetWorld()->GetSubsystem<USHIStatStoreSubsystem>() : nullptr)
+        {
+            FSHIModifierLayers Layers;
+            FoldModifiers(Layers);
+            StatStore->SetRowInputs(StatStoreRow, BaseStats + EquipmentBonuses, Layers);
+            return;
+        }
     }
     
-    // Ensure minimum stat values
-    CurrentStats.Guc = FMath::Max(1.0f, CurrentStats.Guc);
-    CurrentStats.Ceviklik = FMath::Max(1.0f, CurrentStats.Ceviklik);
-    CurrentStats.Zeka = FMath::Max(1.0f, CurrentStats.Zeka);
-    CurrentStats.Odaklanma = FMath::Max(1.0f, CurrentStats.Odaklanma);
-    CurrentStats.Dayaniklilik = FMath::Max(1.0f, CurrentStats.Dayaniklilik);
+    const FSHICharacterStats OldStats = CurrentStats;
+    EvaluateModifiers();
     
-    // Force replication if we're on the server (FIXED)
-    if (GetOwner() && GetOwner()->HasAuthority())
+    // Only derived stats reading a changed input are recomputed, on their next read
+    const uint8 ChangedMask = GetChangedStatMask(OldStats, CurrentStats);
+    if (ChangedMask != 0)
     {
-        OnRep_CurrentStats();
+        StatsVersion++;
+        InvalidateDerivedStats(ChangedMask);
+        QueueStatNotifications();
+        
+        if (GetOwner() && GetOwner()->HasAuthority())
+        {
+            SyncResourceMaximums();
+        }
     }
     
-    // Broadcast recalculation event
-    OnStatsRecalculated.Broadcast();
-    
     UE_LOG(LogTemp, VeryVerbose, TEXT("Stats recalculated - Total Güç: %f (Base: %f + Equipment: %f)"), 
            CurrentStats.Guc, BaseStats.Guc, EquipmentBonuses.Guc);
 }
 
+void USHIStatsComponent::ApplyStoreResults(const FSHICharacterStats& NewStats, const float* DerivedValues)
+{
+    const uint8 ChangedMask = GetChangedStatMask(CurrentStats, NewStats);
+    CurrentStats = NewStats;
+    
+    // The store computed the derived stats in the same batch
+    FMemory::Memcpy(DerivedStatCache, DerivedValues, sizeof(DerivedStatCache));
+    DirtyDerivedStats = 0;
+    
+    if (ChangedMask != 0)
+    {
+        StatsVersion++;
+        bThresholdBonusesDirty = true;
+        QueueStatNotifications();
+        SyncResourceMaximums();
+    }
+}
+
+void USHIStatsComponent::EvaluateModifiers()
+{
+    // Inputs: base + equipment
+    const FSHICharacterStats Inputs = BaseStats + EquipmentBonuses;
+    
+    FSHIModifierLayers Layers;
+    FoldModifiers(Layers);
+    
+    for (int32 i = 0; i < NumCoreStats; i++)
+    {
+        const ESHIStatType Stat = static_cast<ESHIStatType>(i);
+        CurrentStats.SetStat(Stat, FSHIModifierLayers::Combine(Inputs.GetStat(Stat), Layers.Flat[i], Layers.Percent[i], (Layers.OverrideMask >> i) & 1, Layers.Override[i]));
+    }
+}
+
+void USHIStatsComponent::FoldModifiers(FSHIModifierLayers& OutLayers) const
+{
+    float* Flat = OutLayers.Flat;
+    float* Percent = OutLayers.Percent;
+    
+    // Strongest modifier per (source, stat, op), folded in after the pass
+    TMap<TTuple<FName, ESHIStatType, ESHIModifierOp>, float, TInlineSetAllocator<8>> StrongestPerSource;
+    
+    // One pass - the list is sorted by priority, so the last override seen is the winning one
+    for (const FSHIActiveModifier& Modifier : ActiveModifiers)
+    {
+        const FSHIStatModifierSpec& Spec = Modifier.Spec;
+        const int32 i = (int32)Spec.Stat;
+        
+        if (Spec.Op == ESHIModifierOp::Sabitle)
+        {
+            OutLayers.Override[i] = Spec.Value;
+            OutLayers.OverrideMask |= 1 << i;
+        }
+        else if (Spec.Stacking == ESHIModifierStacking::KaynakEnYuksek)
+        {
+            const TTuple<FName, ESHIStatType, ESHIModifierOp> Key(Spec.Source, Spec.Stat, Spec.Op);
+            const float* Strongest = StrongestPerSource.Find(Key);
+            if (!Strongest || FMath::Abs(Spec.Value) > FMath::Abs(*Strongest))
+            {
+                StrongestPerSource.Add(Key, Spec.Value);
+            }
+        }
+        else if (Spec.Op == ESHIModifierOp::Ekle)
+        {
+            Flat[i] += Spec.Value;
+        }
+        else
+        {
+            Percent[i] += Spec.Value;
+        }
+    }
+    
+    for (const auto& Strongest : StrongestPerSource)
+    {
+        const int32 i = (int32)Strongest.Key.Get<1>();
+        if (Strongest.Key.Get<2>() == ESHIModifierOp::Ekle)
+        {
+            Flat[i] += Strongest.Value;
+        }
+        else
+        {
+            Percent[i] += Strongest.Value;
+        }
+    }
+}
+
 float USHIStatsComponent::GetStatByName(const FSHICharacterStats& Stats, FName StatName) const
 {
-    if (StatName == "Guc") return Stats.Guc;
-    if (StatName == "Ceviklik") return Stats.Ceviklik;
-    if (StatName == "Zeka") return Stats.Zeka;
-    if (StatName == "Odaklanma") return Stats.Odaklanma;
-    if (StatName == "Dayaniklilik") return Stats.Dayaniklilik;
-    return 0.0f;
+    const ESHIStatType Stat = FSHIStatModifier::ResolveStatName(StatName);
+    return Stat != ESHIStatType::Max ? Stats.GetStat(Stat) : 0.0f;
 }
 
 void USHIStatsComponent::SetStatByName(FSHICharacterStats& Stats, FName StatName, float Value)
 {
-    if (StatName == "Guc") Stats.Guc = Value;
-    else if (StatName == "Ceviklik") Stats.Ceviklik = Value;
-    else if (StatName == "Zeka") Stats.Zeka = Value;
-    else if (StatName == "Odaklanma") Stats.Odaklanma = Value;
-    else if (StatName == "Dayaniklilik") Stats.Dayaniklilik = Value;
+    const ESHIStatType Stat = FSHIStatModifier::ResolveStatName(StatName);
+    if (Stat != ESHIStatType::Max)
+    {
+        Stats.SetStat(Stat, Value);
+    }
 }
 
 void USHIStatsComponent::DebugPrintStats() const
@@ -259,6 +1056,14 @@ void USHIStatsComponent::DebugPrintStats() const
     UE_LOG(LogTemp, Warning, TEXT("  Odaklanma: +%f"), EquipmentBonuses.Odaklanma);
     UE_LOG(LogTemp, Warning, TEXT("  Dayanıklılık: +%f"), EquipmentBonuses.Dayaniklilik);
     
+    UE_LOG(LogTemp, Warning, TEXT("ACTIVE MODIFIERS: %d"), ActiveModifiers.Num());
+    for (const FSHIActiveModifier& Modifier : ActiveModifiers)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("  [%d] %s %s %f (source %s, priority %d)"), 
+               Modifier.HandleId, *UEnum::GetValueAsString(Modifier.Spec.Stat), *UEnum::GetValueAsString(Modifier.Spec.Op), 
+               Modifier.Spec.Value, *Modifier.Spec.Source.ToString(), Modifier.Spec.Priority);
+    }
+    
     UE_LOG(LogTemp, Warning, TEXT("CURRENT STATS (Total):"));
     UE_LOG(LogTemp, Warning, TEXT("  Güç: %f"), CurrentStats.Guc);
     UE_LOG(LogTemp, Warning, TEXT("  Çeviklik: %f"), CurrentStats.Ceviklik);
@@ -279,4 +1084,132 @@ FString USHIStatsComponent::GetStatsDebugString() const
     return FString::Printf(TEXT("Güç:%0.f Çev:%0.f Zeka:%0.f Odak:%0.f Bünye:%0.f (Sağlık:%0.f)"), 
                           GetCurrentGuc(), GetCurrentCeviklik(), GetCurrentZeka(), 
                           GetCurrentOdaklanma(), GetCurrentDayaniklilik(), GetMaxSaglik());
+}
+
+TSharedRef<const FSHIStatRules> FSHIStatRules::Get(const UDataTable* FormulaTable, const UDataTable* ThresholdTable)
+{
+    // Every component using the same tables shares one compiled set
+    static TMap<TPair<FObjectKey, FObjectKey>, TSharedRef<const FSHIStatRules>> RulesCache;
+    
+#if WITH_EDITOR
+    // One change listener per table, however many table pairs it is part of
+    static TMap<FObjectKey, FDelegateHandle> TableChangedHandles;
+#endif
+    
+    const TPair<FObjectKey, FObjectKey> CacheKey(FObjectKey(FormulaTable), FObjectKey(ThresholdTable));
+    if (const TSharedRef<const FSHIStatRules>* Cached = RulesCache.Find(CacheKey))
+    {
+        return *Cached;
+    }
+    
+    TSharedRef<FSHIStatRules> Rules = MakeShared<FSHIStatRules>();
+    
+    // Built-in formulas, a table row for the same stat replaces them
+    static const TCHAR* DefaultFormulas[] =
+    {
+        TEXT("100 + Dayaniklilik * 15"),
+        TEXT("50 + Zeka * 8 + Odaklanma * 5"),
+        TEXT("Guc * 0.8 + Ceviklik * 0.3"),
+        TEXT("Dayaniklilik * 0.5 + Ceviklik * 0.2")
+    };
+    static_assert(UE_ARRAY_COUNT(DefaultFormulas) == (int32)ESHIDerivedStat::Max, "Default formulas must match ESHIDerivedStat");
+    
+    FString Error;
+    for (int32 i = 0; i < (int32)ESHIDerivedStat::Max; i++)
+    {
+        FSHICompiledFormula::Compile(DefaultFormulas[i], Rules->DerivedFormulas[i], Error);
+    }
+    
+    if (FormulaTable && FormulaTable->GetRowStruct() == FSHIDerivedStatFormulaRow::StaticStruct())
+    {
+        FormulaTable->ForeachRow<FSHIDerivedStatFormulaRow>(TEXT("SHI Stat Rules"), [&Rules](const FName& RowName, const FSHIDerivedStatFormulaRow& Row)
+        {
+            if (Row.Stat >= ESHIDerivedStat::Max)
+            {
+                return;
+            }
+            
+            FSHICompiledFormula Compiled;
+            FString CompileError;
+            if (FSHICompiledFormula::Compile(Row.Expression, Compiled, CompileError))
+            {
+                Rules->DerivedFormulas[(uint8)Row.Stat] = MoveTemp(Compiled);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("Stat formula %s (\"%s\") ignored: %s"), *RowName.ToString(), *Row.Expression, *CompileError);
+            }
+        });
+    }
+    
+    if (ThresholdTable && ThresholdTable->GetRowStruct() == FSHIStatThresholdRow::StaticStruct())
+    {
+        ThresholdTable->ForeachRow<FSHIStatThresholdRow>(TEXT("SHI Stat Rules"), [&Rules](const FName& RowName, const FSHIStatThresholdRow& Row)
+        {
+            if (Row.Stat < ESHIStatType::Max)
+            {
+                FThreshold& Threshold = Rules->Thresholds.AddDefaulted_GetRef();
+                Threshold.Stat = Row.Stat;
+                Threshold.Value = Row.Threshold;
+                Threshold.BonusText = Row.BonusText;
+            }
+        });
+    }
+    else
+    {
+        // Built-in thresholds
+        auto AddThreshold = [&Rules](ESHIStatType Stat, float Value, const TCHAR* Text)
+        {
+            FThreshold& Threshold = Rules->Thresholds.AddDefaulted_GetRef();
+            Threshold.Stat = Stat;
+            Threshold.Value = Value;
+            Threshold.BonusText = FText::FromString(Text);
+        };
+        AddThreshold(ESHIStatType::Guc, 50.0f, TEXT("Güç 50+: Ağır saldırı +15% stamina hasarı"));
+        AddThreshold(ESHIStatType::Guc, 100.0f, TEXT("Güç 100+: Ağır saldırı +20% hasar"));
+        AddThreshold(ESHIStatType::Guc, 150.0f, TEXT("Güç 150+: Hafif saldırı %10 yavaşlatma"));
+        AddThreshold(ESHIStatType::Ceviklik, 50.0f, TEXT("Çeviklik 50+: Arkadan saldırı +15% hasar"));
+        AddThreshold(ESHIStatType::Ceviklik, 100.0f, TEXT("Çeviklik 100+: Kaçınma sonrası +20% hasar"));
+    }
+    
+    RulesCache.Add(CacheKey, Rules);
+    
+#if WITH_EDITOR
+    // Balancing edits in the editor are picked up by the next component that asks
+    for (const UDataTable* Table : { FormulaTable, ThresholdTable })
+    {
+        if (!Table || TableChangedHandles.Contains(FObjectKey(Table)))
+        {
+            continue;
+        }
+        
+        const FObjectKey TableKey(Table);
+        TableChangedHandles.Add(TableKey, const_cast<UDataTable*>(Table)->OnDataTableChanged().AddLambda([TableKey]()
+        {
+            // Evict every set built from this table, the listener goes with them
+            for (auto It = RulesCache.CreateIterator(); It; ++It)
+            {
+                if (It.Key().Key == TableKey || It.Key().Value == TableKey)
+                {
+                    It.RemoveCurrent();
+                }
+            }
+            
+            FDelegateHandle Handle;
+            if (TableChangedHandles.RemoveAndCopyValue(TableKey, Handle))
+            {
+                if (UDataTable* ChangedTable = Cast<UDataTable>(TableKey.ResolveObjectPtr()))
+                {
+                    ChangedTable->OnDataTableChanged().Remove(Handle);
+                }
+            }
+        }));
+    }
+#endif
+    
+    UE_LOG(LogTemp, Log, TEXT("SHI Stat rules compiled (%s, %s)"), 
+           FormulaTable ? *FormulaTable->GetName() : TEXT("built-in formulas"), 
+           ThresholdTable ? *ThresholdTable->GetName() : TEXT("built-in thresholds"));
+    
+    return Rules;
 }
\ No newline at end of file
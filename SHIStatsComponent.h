@@ -3,14 +3,163 @@
 #include "Components/ActorComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/DataTable.h"
+#include "Data/SHIItemData.h"
+#include "Data/SHIStatFormula.h"
 #include "SHIStatsComponent.generated.h"
 
-// Forward declaration
-struct FSHIStatModifier;
+// Stats derived from the core stats - cached until one of their inputs changes
+UENUM(BlueprintType)
+enum class ESHIDerivedStat : uint8
+{
+    MaxSaglik       UMETA(DisplayName = "Max Sağlık"),    // Max Health
+    MaxEnerji       UMETA(DisplayName = "Max Enerji"),    // Max Mana
+    HasarBonusu     UMETA(DisplayName = "Hasar Bonusu"),  // Damage Bonus
+    Savunma         UMETA(DisplayName = "Savunma"),       // Defense
+    
+    Max UMETA(Hidden)
+};
+
+// Resource pools backed by derived max stats
+UENUM(BlueprintType)
+enum class ESHIResourceType : uint8
+{
+    Saglik      UMETA(DisplayName = "Sağlık"),        // Health (max = MaxSaglik)
+    Enerji      UMETA(DisplayName = "Enerji"),        // Mana (max = MaxEnerji)
+    
+    Max UMETA(Hidden)
+};
+
+// A resource with constant regen. Only the value at LastUpdateTime is stored, the current value is
+// computed on read - idle pools cost nothing and only replicate when something changes them.
+USTRUCT(BlueprintType)
+struct FSHIResourcePool
+{
+    GENERATED_BODY()
+
+    // Value at LastUpdateTime
+    UPROPERTY(BlueprintReadOnly, Category = "Resource")
+    float BaseValue = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Resource")
+    float MaxValue = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Resource")
+    float RegenPerSecond = 0.0f;
+
+    // Server world time
+    UPROPERTY(BlueprintReadOnly, Category = "Resource")
+    double LastUpdateTime = 0.0;
+
+    float GetValue(double Now) const
+    {
+        const float Elapsed = (float)FMath::Max(0.0, Now - LastUpdateTime);
+        return FMath::Clamp(BaseValue + RegenPerSecond * Elapsed, 0.0f, MaxValue);
+    }
+
+    // Folds the regen so far into BaseValue, before anything about the pool changes
+    void Rebase(double Now)
+    {
+        BaseValue = GetValue(Now);
+        LastUpdateTime = Now;
+    }
+};
 
-// UE5.6 Enhanced Stat Events
+// How a modifier layer combines with the stat
+UENUM(BlueprintType)
+enum class ESHIModifierOp : uint8
+{
+    Ekle        UMETA(DisplayName = "Ekle"),          // Flat add
+    Yuzde       UMETA(DisplayName = "Yüzde"),         // Percent of (base + equipment + flat)
+    Sabitle     UMETA(DisplayName = "Sabitle")        // Override - highest priority wins
+};
+
+// What happens when a modifier meets others from the same source
+UENUM(BlueprintType)
+enum class ESHIModifierStacking : uint8
+{
+    Yigilir             UMETA(DisplayName = "Yığılır"),                 // Every instance counts
+    KaynakEnYuksek      UMETA(DisplayName = "Kaynak Başına En Yüksek"), // Only the strongest per source counts
+    KaynagiDegistir     UMETA(DisplayName = "Aynı Kaynağı Değiştir")    // A new one replaces the old one
+};
+
+// One modifier on one stat (buffs, debuffs, auras...)
+USTRUCT(BlueprintType)
+struct FSHIStatModifierSpec
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Modifier")
+    ESHIStatType Stat = ESHIStatType::Guc;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Modifier")
+    ESHIModifierOp Op = ESHIModifierOp::Ekle;
+
+    // Flat amount, percent (10 = +10%) or the override value
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Modifier")
+    float Value = 0.0f;
+
+    // Who applied it (ability, item, aura) - used by the stacking rules
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Modifier")
+    FName Source;
+
+    // Higher priority overrides win over lower ones
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Modifier")
+    int32 Priority = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat Modifier")
+    ESHIModifierStacking Stacking = ESHIModifierStacking::Yigilir;
+
+    // Stat, op and stacking packed into 7 bits, priority packed
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSHIStatModifierSpec> : public TStructOpsTypeTraitsBase2<FSHIStatModifierSpec>
+{
+    enum
+    {
+        WithNetSerializer = true
+    };
+};
+
+// Identifies one applied modifier so it can be removed later
+USTRUCT(BlueprintType)
+struct FSHIModifierHandle
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stat Modifier")
+    int32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+};
+
+// Modifier list folded per stat, ready to combine with base + equipment
+struct FSHIModifierLayers
+{
+    float Flat[(uint8)ESHIStatType::Max] = {};
+    float Percent[(uint8)ESHIStatType::Max] = {};
+    float Override[(uint8)ESHIStatType::Max] = {};
+    uint8 OverrideMask = 0;
+
+    // (input + flat) * (1 + percent), unless overridden - never below 1
+    static FORCEINLINE float Combine(float Input, float Flat, float Percent, bool bOverride, float Override)
+    {
+        return FMath::Max(1.0f, bOverride ? Override : (Input + Flat) * (1.0f + Percent / 100.0f));
+    }
+};
+
+// A modifier as stored on the component
+struct FSHIActiveModifier
+{
+    int32 HandleId = 0;
+    FSHIStatModifierSpec Spec;
+};
+
+// UE5.6 Enhanced Stat Events - coalesced, at most one per changed stat (core or derived) per frame
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnStatChanged, FName, StatName, float, OldValue, float, NewValue);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStatsRecalculated);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnResourceChanged, ESHIResourceType, Resource, float, NewValue, float, MaxValue);
 
 // Turkish RPG stat structure
 USTRUCT(BlueprintType)
@@ -54,10 +203,128 @@ struct FSHICharacterStats : public FTableRowBase
         return Result;
     }
 
+    // Indexed access - the five stats are laid out as a float array (checked in the .cpp)
+    float GetStat(ESHIStatType Stat) const { return (&Guc)[(uint8)Stat]; }
+    void SetStat(ESHIStatType Stat, float Value) { (&Guc)[(uint8)Stat] = Value; }
+    const float* GetStatData() const { return &Guc; }
+
     // Apply modifiers from equipment
     void ApplyModifiers(const TArray<FSHIStatModifier>& Modifiers);
+
+    // Sends a 5 bit change mask plus only the fields that changed since the last send, as exact floats
+    // (base and equipment stats are formula inputs, clients evaluating them must see the server's values)
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSHICharacterStats> : public TStructOpsTypeTraitsBase2<FSHICharacterStats>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true
+    };
+};
+
+// Evaluated stats that are only displayed (CurrentStats) - these can go over the wire quantized
+USTRUCT(BlueprintType)
+struct FSHIQuantizedCharacterStats : public FSHICharacterStats
+{
+    GENERATED_BODY()
+
+    FSHIQuantizedCharacterStats() {}
+    FSHIQuantizedCharacterStats(const FSHICharacterStats& Other) : FSHICharacterStats(Other) {}
+
+    // Replication step - stats go over the wire as multiples of this
+    static constexpr float NetQuantizeStep = 0.1f;
+
+    // Same change mask as FSHICharacterStats, changed fields as packed multiples of NetQuantizeStep
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSHIQuantizedCharacterStats> : public TStructOpsTypeTraitsBase2<FSHIQuantizedCharacterStats>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true
+    };
+};
+
+// Derived stat formula row, e.g. MaxSaglik = "100 + Dayaniklilik * 15"
+USTRUCT(BlueprintType)
+struct FSHIDerivedStatFormulaRow : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Formula")
+    ESHIDerivedStat Stat = ESHIDerivedStat::MaxSaglik;
+
+    // Numbers, core stat names (Guc, Ceviklik, Zeka, Odaklanma, Dayaniklilik), + - * / and parentheses
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Formula")
+    FString Expression;
+};
+
+// Attribute bonus unlocked when a core stat reaches a value
+USTRUCT(BlueprintType)
+struct FSHIStatThresholdRow : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Threshold")
+    ESHIStatType Stat = ESHIStatType::Guc;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Threshold")
+    float Threshold = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Threshold")
+    FText BonusText;
+};
+
+// Formulas and thresholds compiled from the rule tables - built once per table pair and shared
+struct FSHIStatRules
+{
+    struct FThreshold
+    {
+        ESHIStatType Stat = ESHIStatType::Guc;
+        float Value = 0.0f;
+        FText BonusText;
+    };
+
+    FSHICompiledFormula DerivedFormulas[(uint8)ESHIDerivedStat::Max];
+    TArray<FThreshold> Thresholds;
+
+    // Null tables (or missing / broken rows) fall back to the built-in rules
+    static TSharedRef<const FSHIStatRules> Get(const UDataTable* FormulaTable, const UDataTable* ThresholdTable);
+};
+
+// What changed between two stat snapshots - bit i of a mask is stat i, deltas are To - From
+struct FSHIStatSnapshotDiff
+{
+    uint8 CoreMask = 0;
+    uint8 DerivedMask = 0;
+    float CoreDelta[(uint8)ESHIStatType::Max] = {};
+    float DerivedDelta[(uint8)ESHIDerivedStat::Max] = {};
+
+    bool HasChanges() const { return (CoreMask | DerivedMask) != 0; }
+};
+
+// Immutable view of a character's stats at one version. Plain data, safe to read on worker threads
+// while the component keeps changing - combat code resolves a hit against the snapshots it captured.
+struct FSHIStatSnapshot
+{
+    // Increases every time the component's current stats change
+    uint32 Version = 0;
+    float Core[(uint8)ESHIStatType::Max] = {};
+    float Derived[(uint8)ESHIDerivedStat::Max] = {};
+
+    float GetStat(ESHIStatType Stat) const { return Stat < ESHIStatType::Max ? Core[(uint8)Stat] : 0.0f; }
+    float GetDerivedStat(ESHIDerivedStat Stat) const { return Stat < ESHIDerivedStat::Max ? Derived[(uint8)Stat] : 0.0f; }
+
+    static FSHIStatSnapshotDiff Diff(const FSHIStatSnapshot& From, const FSHIStatSnapshot& To);
 };
 
+using FSHIStatSnapshotRef = TSharedRef<const FSHIStatSnapshot, ESPMode::ThreadSafe>;
+
 UCLASS(ClassGroup=(SHI), meta=(BlueprintSpawnableComponent))
 class STILLHEREISTANBUL_API USHIStatsComponent : public UActorComponent
 {
@@ -68,23 +335,56 @@ public:
 
 protected:
     // UE5.6 Enhanced Replication - Base stats (permanent character progression)
-    UPROPERTY(Replicated, BlueprintReadOnly, Category = "Character Stats")
+    UPROPERTY(ReplicatedUsing = OnRep_StatInputs, BlueprintReadOnly, Category = "Character Stats")
     FSHICharacterStats BaseStats;
 
-    // Current stats (base + equipment + temporary modifiers)
+    // Current stats (base + equipment + temporary modifiers) - not replicated in deterministic mode
     UPROPERTY(ReplicatedUsing = OnRep_CurrentStats, BlueprintReadOnly, Category = "Character Stats")
-    FSHICharacterStats CurrentStats;
+    FSHIQuantizedCharacterStats CurrentStats;
 
-    // Equipment bonuses (calculated from equipment component)
-    UPROPERTY(BlueprintReadOnly, Category = "Character Stats")
+    // Equipment bonuses (calculated from equipment component) - replicated in deterministic mode only
+    UPROPERTY(ReplicatedUsing = OnRep_StatInputs, BlueprintReadOnly, Category = "Character Stats")
     FSHICharacterStats EquipmentBonuses;
 
+    // Compact copy of the active modifier list, in evaluation order - replicated in deterministic mode only
+    UPROPERTY(ReplicatedUsing = OnRep_StatInputs)
+    TArray<FSHIStatModifierSpec> ReplicatedModifiers;
+
+    // Replicate the evaluator inputs (base, equipment, modifiers) instead of CurrentStats,
+    // clients run the same evaluator the server does
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Replication")
+    bool bDeterministicClientStats = false;
+
     // Temporary modifiers (buffs, debuffs, etc)
     UPROPERTY(BlueprintReadOnly, Category = "Character Stats")
     FSHICharacterStats TemporaryModifiers;
 
+    // Regen per second of each resource pool
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resources")
+    float SaglikRegenPerSecond = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Resources")
+    float EnerjiRegenPerSecond = 2.0f;
+
+    UPROPERTY(ReplicatedUsing = OnRep_ResourcePools)
+    FSHIResourcePool ResourcePools[(uint8)ESHIResourceType::Max];
+
+    // Evaluate in the world's shared stat store (batched with every other registered character) instead of locally.
+    // Results arrive with the store's next tick.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Store")
+    bool bUseSharedStatStore = false;
+
+    // Balancing data - derived stat formulas and threshold bonuses
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Rules", meta = (RequiredAssetDataTags = "RowStructure=/Script/StillHereIstanbul.SHIDerivedStatFormulaRow"))
+    UDataTable* DerivedStatFormulaTable = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat Rules", meta = (RequiredAssetDataTags = "RowStructure=/Script/StillHereIstanbul.SHIStatThresholdRow"))
+    UDataTable* StatThresholdTable = nullptr;
+
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 
 public:
     // Base stat modification (permanent character progression)
@@ -95,16 +395,39 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Stats")
     void ApplyEquipmentBonuses(const TArray<FSHIStatModifier>& EquipmentModifiers);
 
+    // Takes the equipment component's running total - no-op when nothing changed
+    void SetEquipmentBonuses(const FSHIStatVector& Bonuses);
+
     UFUNCTION(BlueprintCallable, Category = "Stats")
     void ClearEquipmentBonuses();
 
-    // Temporary modifier system (for buffs/debuffs)
+    // Layered modifier system (server side, CurrentStats replicates the result)
+    UFUNCTION(BlueprintCallable, Category = "Stats")
+    FSHIModifierHandle AddModifier(const FSHIStatModifierSpec& Spec);
+
     UFUNCTION(BlueprintCallable, Category = "Stats")
-    void ApplyTemporaryModifier(FName StatName, float Amount, float Duration);
+    bool RemoveModifier(FSHIModifierHandle Handle);
 
+    UFUNCTION(BlueprintCallable, Category = "Stats")
+    int32 RemoveModifiersFromSource(FName Source);
+
+    // Temporary modifier system (for buffs/debuffs) - every call adds its own flat modifier
+    UFUNCTION(BlueprintCallable, Category = "Stats")
+    FSHIModifierHandle ApplyTemporaryModifier(FName StatName, float Amount, float Duration);
+
+    // Removes every temporary modifier on the stat
     UFUNCTION(BlueprintCallable, Category = "Stats")
     void RemoveTemporaryModifier(FName StatName);
 
+    // Called by the expiry subsystem with every handle of this component that ran out this tick
+    void ExpireModifiers(TConstArrayView<int32> HandleIds);
+
+    // Called by the shared stat store after it evaluated this component's row
+    void ApplyStoreResults(const FSHICharacterStats& NewStats, const float* DerivedValues);
+
+    const FSHIStatRules& GetStatRules() const;
+    TSharedRef<const FSHIStatRules> GetStatRulesRef() const;
+
     // Stat access functions (current stats = base + equipment + temporary)
     UFUNCTION(BlueprintPure, Category = "Stats Access")
     FSHICharacterStats GetBaseStats() const { return BaseStats; }
@@ -131,7 +454,19 @@ public:
     UFUNCTION(BlueprintPure, Category = "Stats Access")
     float GetCurrentDayaniklilik() const { return CurrentStats.Dayaniklilik; }
 
-    // Derived stats (Istanbul-themed calculations)
+    // Shared and cached per version - capturing again before anything changed returns the same snapshot
+    FSHIStatSnapshotRef CaptureSnapshot() const;
+
+    UFUNCTION(BlueprintPure, Category = "Stats Access")
+    int32 GetStatsVersion() const { return (int32)StatsVersion; }
+
+    UFUNCTION(BlueprintPure, Category = "Stats Access")
+    float GetCurrentStat(ESHIStatType Stat) const { return Stat < ESHIStatType::Max ? CurrentStats.GetStat(Stat) : 0.0f; }
+
+    // Derived stats (Istanbul-themed calculations) - served from the cache
+    UFUNCTION(BlueprintPure, Category = "Derived Stats")
+    float GetDerivedStat(ESHIDerivedStat Stat) const;
+
     UFUNCTION(BlueprintPure, Category = "Derived Stats")
     float GetMaxSaglik() const; // Max Sağlık (Health)
 
@@ -158,21 +493,104 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Events")
     FOnStatsRecalculated OnStatsRecalculated;
 
+    // Resource pools (Sağlık / Enerji)
+    UFUNCTION(BlueprintPure, Category = "Resources")
+    float GetResource(ESHIResourceType Resource) const;
+
+    UFUNCTION(BlueprintPure, Category = "Resources")
+    float GetResourceMax(ESHIResourceType Resource) const;
+
+    UFUNCTION(BlueprintPure, Category = "Resources")
+    float GetResourcePercent(ESHIResourceType Resource) const;
+
+    // Server only - restores the pool a consumable's potion trait names, by the item's restore amount.
+    // Called by the server code that removes the consumable, false if the item restores nothing.
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Resources")
+    bool ApplyConsumable(const USHIItemData* Item);
+
+    // Server only - false (and nothing spent) if there is not enough
+    UFUNCTION(BlueprintCallable, Category = "Resources")
+    bool ConsumeResource(ESHIResourceType Resource, float Amount);
+
+    // Server only - negative amounts drain
+    UFUNCTION(BlueprintCallable, Category = "Resources")
+    void ModifyResource(ESHIResourceType Resource, float Amount);
+
+    // Fired when a pool is changed by something other than regen
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnResourceChanged OnResourceChanged;
+
 protected:
     // Network replication
     UFUNCTION()
     void OnRep_CurrentStats();
 
-    // Internal stat calculation
+    // Deterministic mode - an evaluator input arrived, recompute locally
+    UFUNCTION()
+    void OnRep_StatInputs();
+
+    UFUNCTION()
+    void OnRep_ResourcePools();
+
+    // Server world time on both sides, so replicated pools regen identically
+    double GetResourceTime() const;
+
+    // Authority - pool maximums follow MaxSaglik / MaxEnerji, keeping the filled fraction
+    void InitializeResourcePools();
+    void SyncResourceMaximums();
+
+    // Internal stat calculation - only re-evaluates when an input changed since the last run
     void RecalculateCurrentStats();
+    void MarkStatsDirty() { bStatsDirty = true; }
+
+    // Server always, clients only in deterministic mode - otherwise CurrentStats comes from the server
+    bool EvaluatesStatsLocally() const;
+
+    // Folds the whole modifier list in one pass
+    void FoldModifiers(FSHIModifierLayers& OutLayers) const;
+    void EvaluateModifiers();
+
+    // Dependency tracking - bit i of a stat mask is ESHIStatType i
+    float ComputeDerivedStat(ESHIDerivedStat Stat, const FSHICharacterStats& Stats) const;
+    uint8 GetDerivedStatInputs(ESHIDerivedStat Stat) const;
+    static uint8 GetChangedStatMask(const FSHICharacterStats& A, const FSHICharacterStats& B);
+    void InvalidateDerivedStats(uint8 ChangedStatMask);
+
+    // Change events are sent once per frame from the difference to what listeners last saw
+    void QueueStatNotifications();
+    void FlushStatNotifications();
 
     // Helper functions
     float GetStatByName(const FSHICharacterStats& Stats, FName StatName) const;
     void SetStatByName(FSHICharacterStats& Stats, FName StatName, float Value);
 
-    // Temporary modifiers with timers
-    TMap<FName, FTimerHandle> TempModifierTimers;
-    TMap<FName, float> TempModifierValues;
+    mutable TSharedPtr<const FSHIStatRules> StatRules;
+
+    // Bumped on every CurrentStats change, snapshots carry it
+    uint32 StatsVersion = 1;
+    mutable TSharedPtr<const FSHIStatSnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+
+    // Client copy of CurrentStats as of the previous OnRep - delta serialized properties get no old value
+    FSHICharacterStats LastReplicatedStats;
+
+    // Row in the shared stat store, INDEX_NONE when evaluating locally
+    int32 StatStoreRow = INDEX_NONE;
+
+    // Kept sorted by priority (then insertion order) so the evaluator can fold it front to back
+    TArray<FSHIActiveModifier> ActiveModifiers;
+    int32 NextModifierHandle = 1;
+    bool bStatsDirty = true;
+
+    mutable float DerivedStatCache[(uint8)ESHIDerivedStat::Max] = {};
+    mutable uint8 DirtyDerivedStats = 0xFF;
+
+    // Rebuilt only after a core stat changed
+    mutable TArray<FText> CachedThresholdBonuses;
+    mutable bool bThresholdBonusesDirty = true;
+
+    // Stats as of the last notification flush
+    FSHICharacterStats NotifiedStats;
+    bool bStatNotifyScheduled = false;
 
 public:
     // Debug functions
@@ -6,10 +6,12 @@
 #include "Components/SHIInventoryComponent.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
 
 ASHIWorldItem::ASHIWorldItem()
 {
     PrimaryActorTick.bCanEverTick = true;
+    bReplicates = true;
 
     // Create root component
     RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -77,6 +79,29 @@ void ASHIWorldItem::BeginPlay()
     }
 }
 
+void ASHIWorldItem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(ASHIWorldItem, ItemData);
+    DOREPLIFETIME(ASHIWorldItem, ItemQuantity);
+}
+
+void ASHIWorldItem::OnRep_ItemQuantity()
+{
+    RefreshItemNameWidget();
+}
+
+void ASHIWorldItem::RefreshItemNameWidget()
+{
+    if (ItemNameWidget)
+    {
+        ItemNameWidget->RequestRedraw();
+    }
+
+    OnItemQuantityChanged.Broadcast(ItemQuantity);
+}
+
 void ASHIWorldItem::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
@@ -142,23 +167,39 @@ bool ASHIWorldItem::TryPickupItem(ASHICharacter* Character)
         return false;
     }
     
-    // Check if inventory can hold the item
-    if (InventoryComponent->CanAddItem(ItemData, ItemQuantity))
+    // Add as much as fits in one pass - the remainder stays on the ground
+    const int32 PickedUp = InventoryComponent->TryAddItem(ItemData, ItemQuantity);
+    if (PickedUp > 0)
     {
-        // Add item to inventory
-        InventoryComponent->Server_AddItem(ItemData, ItemQuantity);
-        
         UE_LOG(LogTemp, Log, TEXT("Player picked up %s x%d"), 
-               *ItemData->ItemName.ToString(), ItemQuantity);
+               *ItemData->ItemName.ToString(), PickedUp);
         
         // Show pickup feedback
         if (GEngine)
         {
             FString PickupText = FString::Printf(TEXT("Alındı: %s x%d"), 
-                                               *ItemData->ItemName.ToString(), ItemQuantity);
+                                               *ItemData->ItemName.ToString(), PickedUp);
             GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, PickupText);
         }
         
+        if (PickedUp < ItemQuantity)
+        {
+            ItemQuantity -= PickedUp;
+            RefreshItemNameWidget();
+            
+            UE_LOG(LogTemp, Log, TEXT("Inventory full, %d of %s left on the ground"), 
+                   ItemQuantity, *ItemData->ItemName.ToString());
+            
+            if (GEngine)
+            {
+                FString RemainderText = FString::Printf(TEXT("Envanter dolu (%d/%d), yerde kaldı: %s x%d"), 
+                                                      InventoryComponent->GetUsedSlotCount(), InventoryComponent->InventorySize,
+                                                      *ItemData->ItemName.ToString(), ItemQuantity);
+                GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, RemainderText);
+            }
+            return true;
+        }
+        
         // Destroy the world item
         Destroy();
         return true;
@@ -184,6 +225,7 @@ void ASHIWorldItem::InitializeWorldItem(USHIItemData* InItemData, int32 InQuanti
 {
     ItemData = InItemData;
     ItemQuantity = InQuantity;
+    RefreshItemNameWidget();
     
     if (ItemData)
     {
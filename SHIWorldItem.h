@@ -8,6 +8,8 @@
 #include "Data/SHIItemData.h"
 #include "SHIWorldItem.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWorldItemQuantityChanged, int32, NewQuantity);
+
 UCLASS()
 class STILLHEREISTANBUL_API ASHIWorldItem : public AActor
 {
@@ -28,10 +30,11 @@ protected:
     UWidgetComponent* ItemNameWidget;
 
     // Item Properties
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties")
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Replicated, Category = "Item Properties")
     USHIItemData* ItemData;
     
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties")
+    // Replicated so a partial pickup updates the amount shown on clients
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_ItemQuantity, Category = "Item Properties")
     int32 ItemQuantity = 1;
     
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties")
@@ -55,6 +58,13 @@ protected:
 
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    UFUNCTION()
+    void OnRep_ItemQuantity();
+
+    // Redraws the name widget and notifies listeners after the quantity changes
+    void RefreshItemNameWidget();
 
     // Interaction events
     UFUNCTION()
@@ -81,4 +91,8 @@ public:
     
     UFUNCTION(BlueprintPure, Category = "Item Info")
     FText GetItemDisplayName() const;
+
+    // Fired on server and clients when the remaining quantity changes
+    UPROPERTY(BlueprintAssignable, Category = "Item Info")
+    FOnWorldItemQuantityChanged OnItemQuantityChanged;
 };
\ No newline at end of file
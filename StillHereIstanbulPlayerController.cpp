@@ -5,6 +5,8 @@
 #include "EnhancedInputSubsystems.h"
 #include "Engine/LocalPlayer.h"
 #include "InputMappingContext.h"
+#include "Engine/NetConnection.h"
+#include "Data/SHIItemRegistry.h"
 
 void AStillHereIstanbulPlayerController::SetupInputComponent()
 {
@@ -19,3 +21,62 @@ void AStillHereIstanbulPlayerController::SetupInputComponent()
 		}
 	}
 }
+
+void AStillHereIstanbulPlayerController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Until the server confirms the hash, items on this connection replicate as object references
+	if (IsLocalController() && GetNetMode() == NM_Client)
+	{
+		if (USHIItemRegistry* Registry = USHIItemRegistry::Get())
+		{
+			Registry->CallOrRegister_OnItemsPreloaded(FSimpleDelegate::CreateUObject(this, &AStillHereIstanbulPlayerController::ReportItemRegistryHash));
+		}
+	}
+}
+
+void AStillHereIstanbulPlayerController::ReportItemRegistryHash()
+{
+	if (USHIItemRegistry* Registry = USHIItemRegistry::Get())
+	{
+		Server_ReportItemRegistryHash(Registry->GetContentHash());
+	}
+}
+
+void AStillHereIstanbulPlayerController::Server_ReportItemRegistryHash_Implementation(uint32 ClientHash)
+{
+	USHIItemRegistry* Registry = USHIItemRegistry::Get();
+	UNetConnection* Connection = GetNetConnection();
+	if (!Registry || !Connection)
+	{
+		return;
+	}
+
+	if (ClientHash != Registry->GetContentHash())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Item registry mismatch for %s (client %08x, server %08x) - using object references"),
+			*GetName(), ClientHash, Registry->GetContentHash());
+		return;
+	}
+
+	// The server resolves the client's ids as well, so its items must be loaded too
+	if (!Registry->AreItemsPreloaded())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Item registry still loading on the server - %s keeps object references"), *GetName());
+		return;
+	}
+
+	Registry->EnableItemIds(Connection->PackageMap);
+	Client_ConfirmItemRegistry();
+}
+
+void AStillHereIstanbulPlayerController::Client_ConfirmItemRegistry_Implementation()
+{
+	USHIItemRegistry* Registry = USHIItemRegistry::Get();
+	UNetConnection* Connection = GetNetConnection();
+	if (Registry && Connection)
+	{
+		Registry->EnableItemIds(Connection->PackageMap);
+	}
+}
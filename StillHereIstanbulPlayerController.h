@@ -26,4 +26,17 @@ protected:
 	/** Input mapping context setup */
 	virtual void SetupInputComponent() override;
 
+	/** Starts the item registry check on network clients */
+	virtual void BeginPlay() override;
+
+	/** Sends the client's item registry hash once every item is loaded */
+	void ReportItemRegistryHash();
+
+	/** Hashes match - items go as registry ids on this connection, otherwise they stay object references */
+	UFUNCTION(Server, Reliable)
+	void Server_ReportItemRegistryHash(uint32 ClientHash);
+
+	UFUNCTION(Client, Reliable)
+	void Client_ConfirmItemRegistry();
+
 };